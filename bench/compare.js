@@ -0,0 +1,44 @@
+'use strict';
+
+// Compares two result files written by bench/suite.js, printing the change
+// in throughput and tail latency for every workload they share.
+//
+//   node bench/compare.js <baseline.json> <candidate.json>
+
+const fs = require('fs');
+
+if (process.argv.length < 4) {
+  console.error('Usage: node bench/compare.js <baseline.json> <candidate.json>');
+  process.exit(1);
+}
+
+function load(file) {
+  const report = JSON.parse(fs.readFileSync(file, 'utf8'));
+  const byCase = new Map();
+  for (const result of report.results) {
+    const id = `${result.workload} k${result.keySize} v${result.valueSize} n${result.datasetRecords}`;
+    byCase.set(id, result);
+  }
+  return byCase;
+}
+
+function change(before, after) {
+  const percent = ((after - before) / before) * 100;
+  return `${percent >= 0 ? '+' : ''}${percent.toFixed(1)}%`;
+}
+
+const baseline = load(process.argv[2]);
+const candidate = load(process.argv[3]);
+
+console.log(`${'case'.padEnd(32)} ${'ops/s'.padStart(9)} ${'p50'.padStart(9)} ${'p99'.padStart(9)} ${'p999'.padStart(9)}`);
+for (const [id, before] of baseline) {
+  const after = candidate.get(id);
+  if (!after) {
+    continue;
+  }
+  console.log(
+    `${id.padEnd(32)} ${change(before.opsPerSec, after.opsPerSec).padStart(9)}` +
+    ` ${change(before.p50Us, after.p50Us).padStart(9)} ${change(before.p99Us, after.p99Us).padStart(9)}` +
+    ` ${change(before.p999Us, after.p999Us).padStart(9)}`
+  );
+}
\ No newline at end of file
@@ -0,0 +1,70 @@
+'use strict';
+
+// Compares the per-call cost of Transaction.get/put with a handle from
+// Transaction.bind(), which skips the wrapper classes.
+//
+//   node bench/fast-path.js [iterations]
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const mdbx = require('../lib');
+const { TransactionMode, keyBuffer } = mdbx;
+
+const iterations = Number(process.argv[2]) || 1000000;
+const keyCount = 1000;
+const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'mdbxjs-bench-'));
+
+function measure(name, fn) {
+  // Warm up so both paths are optimized before timing
+  for (let i = 0; i < Math.min(iterations, 100000); i++) fn(i);
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < iterations; i++) fn(i);
+  const ns = Number(process.hrtime.bigint() - start) / iterations;
+  console.log(`${name.padEnd(28)} ${ns.toFixed(1).padStart(8)} ns/op`);
+  return ns;
+}
+
+const env = mdbx.open(dir);
+try {
+  const db = env.openDatabase({ name: 'bench' });
+  const keys = [];
+  const names = [];
+  const value = Buffer.alloc(64, 1);
+
+  let txn = env.beginTransaction();
+  for (let i = 0; i < keyCount; i++) {
+    names.push(`key:${String(i).padStart(6, '0')}`);
+    keys.push(Buffer.from(names[i]));
+    txn.put(db, keys[i], value);
+  }
+  txn.commit();
+
+  txn = env.beginTransaction({ mode: TransactionMode.READONLY });
+  const handle = txn.bind(db);
+  const wrapped = measure('Transaction.get', (i) => txn.get(db, keys[i % keyCount]));
+  const bound = measure('bind(db).get', (i) => handle.get(keys[i % keyCount]));
+  console.log(`${'get overhead saved'.padEnd(28)} ${(wrapped - bound).toFixed(1).padStart(8)} ns/op`);
+
+  // String keys, converted per call or written into the shared key area
+  measure('Transaction.get (string)', (i) => txn.get(db, names[i % keyCount]));
+  measure('bind(db).get (keyBuffer)', (i) => handle.get(keyBuffer.write(names[i % keyCount])));
+
+  // Copying into one reused buffer instead of allocating one per read
+  const target = Buffer.allocUnsafe(value.length);
+  measure('Transaction.getInto', (i) => txn.getInto(db, keys[i % keyCount], target));
+  measure('bind(db).getInto', (i) => handle.getInto(keys[i % keyCount], target));
+  txn.abort();
+
+  txn = env.beginTransaction();
+  const writer = txn.bind(db);
+  const wrappedPut = measure('Transaction.put', (i) => txn.put(db, keys[i % keyCount], value));
+  const boundPut = measure('bind(db).put', (i) => writer.put(keys[i % keyCount], value));
+  console.log(`${'put overhead saved'.padEnd(28)} ${(wrappedPut - boundPut).toFixed(1).padStart(8)} ns/op`);
+  txn.abort();
+
+  db.close();
+} finally {
+  env.close();
+  fs.rmSync(dir, { recursive: true, force: true });
+}
\ No newline at end of file
@@ -0,0 +1,211 @@
+// Native microbenchmark: runs each workload twice, once straight against
+// libmdbx and once through MdbxCore, the N-API-free code behind Transaction,
+// Cursor and bound handles, and reports ns/op for both. The difference is
+// what the binding's own record handling costs; the JS-to-native call itself
+// is measured by bench/fast-path.js.
+//
+//   build/Release/mdbxjs_bench [records] [dir]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "core.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Values read are summed into this so the loops can't be optimized away
+volatile size_t sink = 0;
+
+void Check(int rc, const char* what) {
+  if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+    std::fprintf(stderr, "%s: %s\n", what, mdbx_strerror(rc));
+    std::exit(1);
+  }
+}
+
+template <typename F>
+double NsPerOp(size_t ops, F fn) {
+  for (size_t i = 0; i < ops / 10; i++) fn(i);
+  Clock::time_point start = Clock::now();
+  for (size_t i = 0; i < ops; i++) fn(i);
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  return elapsed.count() / static_cast<double>(ops);
+}
+
+void Report(const char* name, double raw, double core) {
+  std::printf("%-18s %10.1f %10.1f %10.1f\n", name, raw, core, core - raw);
+}
+
+MDBX_val Val(const std::string& s) {
+  MDBX_val val;
+  val.iov_base = const_cast<char*>(s.data());
+  val.iov_len = s.size();
+  return val;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t records = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+  std::filesystem::path dir = argc > 2 ? std::filesystem::path(argv[2])
+      : std::filesystem::temp_directory_path() / ("mdbxjs-native-bench-" + std::to_string(std::rand()));
+  std::filesystem::create_directories(dir);
+
+  MDBX_env* env;
+  Check(mdbx_env_create(&env), "mdbx_env_create");
+  Check(mdbx_env_set_maxdbs(env, 4), "mdbx_env_set_maxdbs");
+  Check(mdbx_env_set_geometry(env, -1, -1, intptr_t(4) << 30, -1, -1, -1), "mdbx_env_set_geometry");
+  Check(mdbx_env_open(env, dir.string().c_str(), MDBX_UTTERLY_NOSYNC, 0644), "mdbx_env_open");
+
+  // Keys are sorted record numbers, values compressible 200-byte documents
+  std::vector<std::string> keys(records);
+  for (size_t i = 0; i < records; i++) {
+    char key[32];
+    std::snprintf(key, sizeof(key), "key:%012zu", i);
+    keys[i] = key;
+  }
+  std::string value;
+  while (value.size() < 200) value += "{\"name\":\"bench\",\"count\":42},";
+
+  // Point operations visit the keys in a fixed pseudo-random order
+  std::vector<size_t> order(records);
+  uint32_t x = 2463534242u;
+  for (size_t i = 0; i < records; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    order[i] = x % records;
+  }
+
+  MDBX_txn* txn;
+  MDBX_dbi plain, packed, store;
+  Check(mdbx_txn_begin(env, nullptr, MDBX_TXN_READWRITE, &txn), "mdbx_txn_begin");
+  Check(mdbx_dbi_open(txn, "plain", MDBX_CREATE, &plain), "mdbx_dbi_open");
+  Check(mdbx_dbi_open(txn, "packed", MDBX_CREATE, &packed), "mdbx_dbi_open");
+  Check(mdbx_dbi_open(txn, MdbxCompression::STORE_NAME, MDBX_CREATE, &store), "mdbx_dbi_open");
+  MdbxCompression compression(store, "packed", 64);
+  Check(compression.Open(txn, packed), "MdbxCompression::Open");
+
+  std::string scratch;
+  for (size_t i = 0; i < records; i++) {
+    MDBX_val key = Val(keys[i]), data = Val(value);
+    Check(mdbx_put(txn, plain, &key, &data, MDBX_APPEND), "mdbx_put");
+    Check(MdbxCore::Put(txn, packed, &compression, key, data, MDBX_APPEND, scratch), "MdbxCore::Put");
+  }
+  Check(mdbx_txn_commit(txn), "mdbx_txn_commit");
+
+  std::printf("%zu records, %zu-byte values\n\n", records, value.size());
+  std::printf("%-18s %10s %10s %10s\n", "ns/op", "libmdbx", "core", "overhead");
+
+  // Point reads
+  Check(mdbx_txn_begin(env, nullptr, MDBX_TXN_RDONLY, &txn), "mdbx_txn_begin");
+  {
+    MDBX_val key, data;
+    double raw = NsPerOp(records, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      Check(mdbx_get(txn, plain, &key, &data), "mdbx_get");
+      sink += data.iov_len;
+    });
+    double core = NsPerOp(records, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      Check(MdbxCore::Get(txn, plain, nullptr, key, data, scratch), "MdbxCore::Get");
+      sink += data.iov_len;
+    });
+    Report("get", raw, core);
+
+    // The raw read returns the stored LZ4 block, so this shows the cost of
+    // decompressing on every read
+    raw = NsPerOp(records, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      Check(mdbx_get(txn, packed, &key, &data), "mdbx_get");
+      sink += data.iov_len;
+    });
+    core = NsPerOp(records, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      Check(MdbxCore::Get(txn, packed, &compression, key, data, scratch), "MdbxCore::Get");
+      sink += data.iov_len;
+    });
+    Report("get (lz4)", raw, core);
+  }
+
+  // Range scans of 100 records from random starting points
+  {
+    MDBX_cursor* cursor;
+    Check(mdbx_cursor_open(txn, plain, &cursor), "mdbx_cursor_open");
+    size_t scans = records / 10 + 1;
+    MDBX_val key, data;
+    double raw = NsPerOp(scans, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      int rc = mdbx_cursor_get(cursor, &key, &data, MDBX_SET_RANGE);
+      for (size_t n = 1; rc == MDBX_SUCCESS && n < 100; n++) {
+        sink += data.iov_len;
+        rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT);
+      }
+      Check(rc, "mdbx_cursor_get");
+    });
+    std::vector<MDBX_val> pairs;
+    double core = NsPerOp(scans, [&](size_t i) {
+      MdbxCore::Range range;
+      range.start = Val(keys[order[i]]);
+      range.hasStart = true;
+      range.limit = 100;
+      size_t count = 0;
+      pairs.clear();
+      Check(MdbxCore::ScanRange(cursor, range, &pairs, count), "MdbxCore::ScanRange");
+      sink += count;
+    });
+    Report("range (100)", raw, core);
+
+    // Whole-table walks, per record
+    size_t walks = 5;
+    raw = NsPerOp(walks, [&](size_t) {
+      int rc = mdbx_cursor_get(cursor, &key, &data, MDBX_FIRST);
+      while (rc == MDBX_SUCCESS) {
+        sink += data.iov_len;
+        rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT);
+      }
+      Check(rc, "mdbx_cursor_get");
+    }) / static_cast<double>(records);
+    core = NsPerOp(walks, [&](size_t) {
+      MdbxCore::Range range;
+      size_t count = 0;
+      pairs.clear();
+      Check(MdbxCore::ScanRange(cursor, range, &pairs, count), "MdbxCore::ScanRange");
+      sink += count;
+    }) / static_cast<double>(records);
+    Report("cursor walk", raw, core);
+    mdbx_cursor_close(cursor);
+  }
+  mdbx_txn_abort(txn);
+
+  // Overwrites within one write transaction, aborted so both runs start from
+  // the same tree
+  {
+    MDBX_val key, data;
+    Check(mdbx_txn_begin(env, nullptr, MDBX_TXN_READWRITE, &txn), "mdbx_txn_begin");
+    double raw = NsPerOp(records, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      data = Val(value);
+      Check(mdbx_put(txn, plain, &key, &data, MDBX_UPSERT), "mdbx_put");
+    });
+    mdbx_txn_abort(txn);
+    Check(mdbx_txn_begin(env, nullptr, MDBX_TXN_READWRITE, &txn), "mdbx_txn_begin");
+    double core = NsPerOp(records, [&](size_t i) {
+      key = Val(keys[order[i]]);
+      Check(MdbxCore::Put(txn, plain, nullptr, key, Val(value), MDBX_UPSERT, scratch), "MdbxCore::Put");
+    });
+    mdbx_txn_abort(txn);
+    Report("put", raw, core);
+  }
+
+  mdbx_env_close(env);
+  if (argc <= 2) {
+    std::filesystem::remove_all(dir);
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+'use strict';
+
+// Benchmark suite: runs each workload over a matrix of key sizes, value
+// sizes and dataset sizes, reporting throughput and latency percentiles.
+// Results are written as JSON so runs can be compared with bench/compare.js.
+//
+//   npm run bench -- [--quick] [--filter <workload>] [--out <file>] [--nosync]
+//
+// Latencies are timed per operation (per batch for putMany, per scan for
+// range), so they include ~50ns of hrtime overhead.
+
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const mdbx = require('../lib');
+const { EnvFlags, TransactionMode, SeekOperation } = mdbx;
+
+function parseArgs(argv) {
+  const args = { quick: false, filter: null, out: null, nosync: false };
+  for (let i = 0; i < argv.length; i++) {
+    switch (argv[i]) {
+      case '--quick': args.quick = true; break;
+      case '--nosync': args.nosync = true; break;
+      case '--filter': args.filter = argv[++i]; break;
+      case '--out': args.out = argv[++i]; break;
+      default: throw new Error(`Unknown argument: ${argv[i]}`);
+    }
+  }
+  return args;
+}
+
+const args = parseArgs(process.argv.slice(2));
+
+const matrix = args.quick
+  ? { keySizes: [16], valueSizes: [100], records: [10000] }
+  : { keySizes: [16, 64], valueSizes: [32, 1024], records: [10000, 1000000] };
+
+// Operations per workload; commits are far slower than reads
+const ops = args.quick
+  ? { read: 20000, commit: 500, batches: 20, scans: 2000, mixed: 5000 }
+  : { read: 200000, commit: 5000, batches: 100, scans: 20000, mixed: 50000 };
+
+const batchSize = 1000;
+const scanLimit = 100;
+
+// Deterministic xorshift32, so every run touches the same keys
+function random(seed) {
+  let x = seed >>> 0 || 1;
+  return () => {
+    x ^= x << 13;
+    x ^= x >>> 17;
+    x ^= x << 5;
+    return (x >>> 0) / 0x100000000;
+  };
+}
+
+// Keys are zero-padded record numbers, so they sort in insertion order
+function makeKey(i, size) {
+  return Buffer.from(String(i).padStart(size, '0'));
+}
+
+function percentile(sorted, p) {
+  return sorted[Math.min(sorted.length - 1, Math.max(0, Math.ceil(p * sorted.length) - 1))];
+}
+
+// Runs `fn(i)` `count` times, timing each call. `fn` returns how many
+// records the call handled (undefined counts as one).
+function measure(count, fn) {
+  const samples = new Float64Array(count);
+  let records = 0;
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < count; i++) {
+    const t0 = process.hrtime.bigint();
+    const handled = fn(i);
+    samples[i] = Number(process.hrtime.bigint() - t0);
+    records += handled === undefined ? 1 : handled;
+  }
+  const seconds = Number(process.hrtime.bigint() - start) / 1e9;
+  samples.sort();
+  return {
+    ops: count,
+    records,
+    seconds,
+    opsPerSec: count / seconds,
+    recordsPerSec: records / seconds,
+    p50Us: percentile(samples, 0.5) / 1000,
+    p99Us: percentile(samples, 0.99) / 1000,
+    p999Us: percentile(samples, 0.999) / 1000
+  };
+}
+
+const workloads = {
+  get({ env, db, keys }) {
+    const next = random(1);
+    const txn = env.beginTransaction({ mode: TransactionMode.READONLY });
+    try {
+      return measure(ops.read, () => {
+        txn.get(db, keys[(next() * keys.length) | 0]);
+      });
+    } finally {
+      txn.abort();
+    }
+  },
+
+  putCommit({ env, db, keys, value }) {
+    const next = random(2);
+    return measure(ops.commit, () => {
+      const txn = env.beginTransaction();
+      txn.put(db, keys[(next() * keys.length) | 0], value);
+      txn.commit();
+    });
+  },
+
+  putMany({ env, db, keys, value }) {
+    const next = random(3);
+    const values = new Array(batchSize).fill(value);
+    return measure(ops.batches, () => {
+      // Sorted batches, as putMany expects for best locality
+      const first = (next() * (keys.length - batchSize)) | 0;
+      const txn = env.beginTransaction();
+      const written = txn.putMany(db, keys.slice(first, first + batchSize), values);
+      txn.commit();
+      return written;
+    });
+  },
+
+  range({ env, db, keys }) {
+    const next = random(4);
+    const txn = env.beginTransaction({ mode: TransactionMode.READONLY });
+    const cursor = txn.openCursor(db);
+    try {
+      return measure(ops.scans, () => {
+        const packed = cursor.getRange({ start: keys[(next() * keys.length) | 0], limit: scanLimit });
+        return mdbx.unpackRecords(packed).length / 2;
+      });
+    } finally {
+      cursor.close();
+      txn.abort();
+    }
+  },
+
+  cursorWalk({ env, db, keys }) {
+    const txn = env.beginTransaction({ mode: TransactionMode.READONLY });
+    const cursor = txn.openCursor(db);
+    try {
+      const steps = Math.min(keys.length, ops.read);
+      return measure(steps, (i) => {
+        cursor.get(i === 0 ? SeekOperation.FIRST : SeekOperation.NEXT);
+      });
+    } finally {
+      cursor.close();
+      txn.abort();
+    }
+  },
+
+  // 90% single-get read transactions, 10% single-put write transactions
+  mixed({ env, db, keys, value }) {
+    const next = random(5);
+    return measure(ops.mixed, () => {
+      const key = keys[(next() * keys.length) | 0];
+      if (next() < 0.1) {
+        const txn = env.beginTransaction();
+        txn.put(db, key, value);
+        txn.commit();
+      } else {
+        const txn = env.beginTransaction({ mode: TransactionMode.READONLY });
+        txn.get(db, key);
+        txn.abort();
+      }
+    });
+  }
+};
+
+function fill(env, db, keys, value) {
+  for (let first = 0; first < keys.length; first += 10000) {
+    const chunk = keys.slice(first, first + 10000);
+    const txn = env.beginTransaction();
+    txn.putMany(db, chunk, new Array(chunk.length).fill(value), mdbx.WriteFlags.APPEND);
+    txn.commit();
+  }
+}
+
+function run() {
+  const names = Object.keys(workloads).filter((name) => !args.filter || name === args.filter);
+  if (names.length === 0) {
+    throw new Error(`No workload named ${args.filter}; have ${Object.keys(workloads).join(', ')}`);
+  }
+
+  const results = [];
+  console.log(
+    `${'workload'.padEnd(11)} ${'key'.padStart(4)} ${'value'.padStart(6)} ${'records'.padStart(8)}` +
+    ` ${'ops/s'.padStart(11)} ${'p50 us'.padStart(9)} ${'p99 us'.padStart(9)} ${'p999 us'.padStart(9)}`
+  );
+
+  for (const records of matrix.records) {
+    for (const keySize of matrix.keySizes) {
+      for (const valueSize of matrix.valueSizes) {
+        const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'mdbxjs-bench-'));
+        const env = mdbx.open(dir, { flags: args.nosync ? EnvFlags.NOSYNC : 0 });
+        try {
+          const db = env.openDatabase({ name: 'bench' });
+          const keys = Array.from({ length: records }, (_, i) => makeKey(i, keySize));
+          const value = Buffer.alloc(valueSize, 0x61);
+          fill(env, db, keys, value);
+
+          for (const workload of names) {
+            const result = workloads[workload]({ env, db, keys, value });
+            results.push({ workload, keySize, valueSize, datasetRecords: records, ...result });
+            console.log(
+              `${workload.padEnd(11)} ${String(keySize).padStart(4)} ${String(valueSize).padStart(6)}` +
+              ` ${String(records).padStart(8)} ${result.opsPerSec.toFixed(0).padStart(11)}` +
+              ` ${result.p50Us.toFixed(2).padStart(9)} ${result.p99Us.toFixed(2).padStart(9)}` +
+              ` ${result.p999Us.toFixed(2).padStart(9)}`
+            );
+          }
+          db.close();
+        } finally {
+          env.close();
+          fs.rmSync(dir, { recursive: true, force: true });
+        }
+      }
+    }
+  }
+
+  const report = {
+    meta: {
+      date: new Date().toISOString(),
+      node: process.version,
+      platform: `${os.platform()} ${os.arch()}`,
+      cpu: os.cpus()[0] ? os.cpus()[0].model : 'unknown',
+      options: { quick: args.quick, nosync: args.nosync, filter: args.filter }
+    },
+    results
+  };
+
+  const out = args.out ||
+    path.join(__dirname, 'results', `bench-${report.meta.date.replace(/[:.]/g, '-')}.json`);
+  fs.mkdirSync(path.dirname(out), { recursive: true });
+  fs.writeFileSync(out, JSON.stringify(report, null, 2));
+  console.log(`\nResults written to ${out}`);
+}
+
+run();
\ No newline at end of file
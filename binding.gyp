@@ -1,4 +1,9 @@
 {
+  "variables": {
+    # The native benchmark is a dev-only tool, so installs don't build it;
+    # `npm run bench:native` configures with -Dbuild_bench=1
+    "build_bench%": 0
+  },
   "targets": [
     {
       "target_name": "mdbxjs",
@@ -7,7 +12,21 @@
         "src/env.cc",
         "src/txn.cc",
         "src/dbi.cc",
-        "src/cursor.cc"
+        "src/cursor.cc",
+        "src/handle.cc",
+        "src/workers.cc",
+        "src/writer.cc",
+        "src/packed.cc",
+        "src/keycodec.cc",
+        "src/msgpack.cc",
+        "src/sharedkey.cc",
+        "src/utf8.cc",
+        "src/structures.cc",
+        "src/commitstats.cc",
+        "src/metrics.cc",
+        "src/core.cc",
+        "src/lz4.cc",
+        "src/compression.cc"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")",
@@ -50,5 +69,57 @@
         "GCC_ENABLE_CPP_EXCEPTIONS": "YES"
       }
     }
+  ],
+  "conditions": [
+    ["build_bench==1", {
+      "targets": [
+        {
+          "target_name": "mdbxjs_bench",
+          "type": "executable",
+          "sources": [
+            "bench/native/bench.cc",
+            "src/core.cc",
+            "src/lz4.cc",
+            "src/compression.cc"
+          ],
+          "include_dirs": [
+            "<(module_root_dir)/deps/libmdbx",
+            "<(module_root_dir)/deps/libmdbx/build/include",
+            "<(module_root_dir)/src"
+          ],
+          "defines": [
+            "MDBX_BUILD_SHARED_LIBRARY=1"
+          ],
+          "conditions": [
+            ["OS=='win'", {
+              "libraries": ["deps/libmdbx/build/libmdbx.lib"]
+            }],
+            ["OS=='linux'", {
+              "libraries": ["../deps/libmdbx/build/libmdbx.so"],
+              "ldflags": ["-Wl,-rpath=\\$$ORIGIN/../../deps/libmdbx/build", "-Wl,-z,origin"]
+            }],
+            ["OS=='mac'", {
+              "sources": [
+                "src/mdbx_shim.c"
+              ],
+              "xcode_settings": {
+                "OTHER_CPLUSPLUSFLAGS": [
+                  "-DMDBX_OSX=1",
+                  "-D_DARWIN_C_SOURCE",
+                  "-std=c++17"
+                ]
+              }
+            }]
+          ],
+          "cflags_cc": [ "-std=c++17" ],
+          "msvs_settings": {
+            "VCCLCompilerTool": {
+              "AdditionalOptions": [ "/std:c++17" ]
+            }
+          },
+          "cflags_cc!": [ "-fno-exceptions" ]
+        }
+      ]
+    }]
   ]
 }
\ No newline at end of file
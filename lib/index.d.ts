@@ -38,6 +38,12 @@ declare module 'mdbxjs' {
     READWRITE
   }
 
+  export enum TxnFlags {
+    NOSYNC = 0x10000,
+    NOMETASYNC = 0x40000,
+    TRY = 0x10000000
+  }
+
   export enum SeekOperation {
     FIRST,
     FIRST_DUP,
@@ -69,21 +75,98 @@ declare module 'mdbxjs' {
     mapSize?: number;
     maxReaders?: number;
     flags?: EnvFlags | number;
+    readTxnPoolSize?: number;
+    readerCheckInterval?: number;
+    slowReaders?: SlowReaderOptions;
+  }
+
+  export interface SlowReaderOptions {
+    policy?: 'log' | 'wait';
+    waitMs?: number;
   }
 
   export interface TransactionOptions {
     mode?: TransactionMode;
     parent?: Transaction;
+    flags?: TxnFlags | number;
+    zeroCopy?: boolean;
+    asyncCommit?: boolean;
   }
 
   export interface DatabaseOptions {
     name?: string;
     create?: boolean;
     flags?: DatabaseFlags | number;
+    keyEncoding?: 'binary' | 'ordered';
+    valueEncoding?: 'json' | 'msgpack';
+    structures?: boolean;
+    compression?: boolean | { threshold?: number };
+  }
+
+  // Microseconds spent in each phase of a commit
+  export interface CommitLatency {
+    preparation: number;
+    gc: number;
+    audit: number;
+    write: number;
+    sync: number;
+    ending: number;
+    whole: number;
+  }
+
+  export interface CommitHistogram {
+    count: number;
+    totalUs: number;
+    maxUs: number;
+    meanUs: number;
+    p50Us: number;
+    p99Us: number;
+    p999Us: number;
+    // buckets[i] counts durations below 2^i microseconds
+    buckets: number[];
+  }
+
+  export interface ReaderInfo {
+    slot: number;
+    pid: number;
+    thread: number;
+    txnid: number;
+    lag: number;
+    bytesUsed: number;
+    bytesRetained: number;
+  }
+
+  export interface LatencySummary {
+    count: number;
+    meanNs: number;
+    maxNs: number;
+    p50Ns: number;
+    p90Ns: number;
+    p99Ns: number;
+    p999Ns: number;
+  }
+
+  export interface Metrics {
+    gets: number;
+    hits: number;
+    misses: number;
+    puts: number;
+    dels: number;
+    bytesRead: number;
+    bytesWritten: number;
+    txnsBegun: number;
+    txnsCommitted: number;
+    txnsAborted: number;
+    cursorSteps: number;
+    slowReaders: number;
+    latency: { get: LatencySummary; put: LatencySummary; commit: LatencySummary };
   }
 
+  export type OrderedKey = null | boolean | number | bigint | string | Buffer | OrderedKey[];
+
   export class Environment {
     constructor(options?: EnvOptions);
+    readonly writer: Writer;
     open(options?: EnvOptions): void;
     close(): void;
     beginTransaction(options?: TransactionOptions): Transaction;
@@ -91,26 +174,60 @@ declare module 'mdbxjs' {
     sync(force?: boolean): void;
     stat(): { psize: number, depth: number, branch_pages: number, leaf_pages: number, overflow_pages: number, entries: number };
     info(): { mapSize: number, lastPageNumber: number, lastTransactionId: number, maxReaders: number, numReaders: number };
+    commitStats(options?: { reset?: boolean }): Record<keyof CommitLatency, CommitHistogram>;
+    metrics(options?: { reset?: boolean }): Metrics;
+    readers(): ReaderInfo[];
+    checkReaders(): number;
     copy(path: string): void;
     setMapSize(size: number): void;
+    getAsync(dbi: Database, key: Key): Promise<Buffer | null>;
+    putAsync(dbi: Database, key: Key, value: Value, flags?: WriteFlags | number): Promise<void>;
+    delAsync(dbi: Database, key: Key, value?: Value): Promise<boolean>;
+  }
+
+  export class Writer {
+    put(dbi: Database, key: Key, value: Value, flags?: WriteFlags | number): Promise<void>;
+    del(dbi: Database, key: Key, value?: Value): Promise<boolean>;
+    flush(): Promise<void>;
   }
 
   export class Transaction {
     constructor(env: Environment, options?: TransactionOptions);
     abort(): void;
-    commit(): void;
+    commit(): CommitLatency | undefined;
+    commitAsync(): Promise<void>;
     renew(): void;
     reset(): void;
     get(dbi: Database, key: Key): Buffer | null;
+    getString(dbi: Database, key: Key): string | null;
+    getInto(dbi: Database, key: Key, target: Buffer | ArrayBuffer, offset?: number): number | null;
+    getDecoded(dbi: Database, key: Key): any;
+    putEncoded(dbi: Database, key: Key, value: any, flags?: WriteFlags | number): void;
+    getMany(dbi: Database, keys: Key[]): Array<Buffer | null>;
+    getMany(dbi: Database, keys: Buffer): Buffer;
+    getAsync(dbi: Database, key: Key): Promise<Buffer | null>;
     put(dbi: Database, key: Key, value: Value, flags?: WriteFlags | number): void;
+    putMany(dbi: Database, packed: Buffer, flags?: WriteFlags | number): number;
+    putMany(dbi: Database, keys: Key[], values: Value[], flags?: WriteFlags | number): number;
     del(dbi: Database, key: Key, value?: Value): boolean;
     openCursor(dbi: Database): Cursor;
+    bind(dbi: Database): Handle;
+  }
+
+  export interface Handle {
+    get(key: Buffer | string | number): Buffer | null;
+    getString(key: Buffer | string | number): string | null;
+    getInto(key: Buffer | string | number, target: Buffer | ArrayBuffer, offset?: number): number | null;
+    put(key: Buffer | string | number, value: Buffer | string, flags?: WriteFlags | number): void;
+    del(key: Buffer | string | number): boolean;
   }
 
   export class Database {
     constructor(env: Environment, options?: DatabaseOptions);
     close(): void;
     drop(): void;
+    truncate(txn: Transaction): void;
+    trainDictionary(options?: { samples?: number, maxSize?: number }): number;
     stat(txn: Transaction): { entries: number, depth: number, branch_pages: number, leaf_pages: number, overflow_pages: number, page_size: number };
   }
 
@@ -121,16 +238,49 @@ declare module 'mdbxjs' {
     get(op: SeekOperation, key?: Key, value?: Value): KeyValue | null;
     put(key: Key, value: Value, flags?: WriteFlags | number): void;
     count(): number;
+    getRange(options?: RangeOptions): Buffer;
+    countRange(options?: RangeOptions): number;
+    deleteRange(options?: RangeOptions): number;
+  }
+
+  export interface RangeOptions {
+    start?: Key;
+    end?: Key;
+    exclusiveStart?: boolean;
+    inclusiveEnd?: boolean;
+    limit?: number;
+    reverse?: boolean;
   }
 
+  // Order-preserving key codec
+  export function encodeKey(key: OrderedKey): Buffer;
+  export function encodeKey(key: OrderedKey, target: Buffer, offset?: number): number;
+  export function decodeKey(buffer: Buffer): OrderedKey;
+
+  // Native MessagePack value codec
+  export function encodeValue(value: any): Buffer;
+  export function decodeValue(buffer: Buffer): any;
+  export const keyBuffer: Buffer;
+
+  // Length-prefixed record buffers for the batch APIs
+  export function packRecords(records: Buffer[]): Buffer;
+  export function unpackRecords(packed: Buffer): Array<Buffer | null>;
+
   // Simplified interface for beginners
   export function open(path: string, options?: Partial<EnvOptions>): Environment;
   export function collection(env: Environment, name?: string, options?: Partial<DatabaseOptions>): {
     get(key: Key, txnOptions?: TransactionOptions): any;
+    getMany(keys: Key[], txnOptions?: TransactionOptions): any[];
+    getAsync(key: Key): Promise<any>;
+    putAsync(key: Key, value: Value): Promise<void>;
+    delAsync(key: Key): Promise<boolean>;
     put(key: Key, value: Value, txnOptions?: TransactionOptions): void;
+    putMany(entries: Array<[Key, Value]>, txnOptions?: TransactionOptions): number;
     del(key: Key, txnOptions?: TransactionOptions): boolean;
     find(options: { gt?: Key, gte?: Key, lt?: Key, lte?: Key, limit?: number, reverse?: boolean }): Array<KeyValue>;
     count(txnOptions?: TransactionOptions): number;
+    countRange(gte?: Key | null, lt?: Key | null, txnOptions?: TransactionOptions): number;
+    deleteRange(gte?: Key | null, lt?: Key | null, txnOptions?: TransactionOptions): number;
     drop(): void;
     clear(): void;
   };
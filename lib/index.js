@@ -9,6 +9,7 @@ const EnvFlags = binding.EnvFlags;
 const DatabaseFlags = binding.DatabaseFlags;
 const WriteFlags = binding.WriteFlags;
 const TransactionMode = binding.TransactionMode;
+const TxnFlags = binding.TxnFlags;
 const SeekOperation = binding.SeekOperation;
 
 // Helper functions
@@ -29,6 +30,66 @@ function ensureBuffer(key) {
   }
 }
 
+// Keys of databases opened with keyEncoding: 'ordered' go through the native
+// order-preserving codec. Buffers are taken as already encoded.
+function toKeyBuffer(dbi, key) {
+  if (dbi._orderedKeys && !Buffer.isBuffer(key)) {
+    return binding.encodeKey(key);
+  }
+  return ensureBuffer(key);
+}
+
+// The addon's preallocated key area. The native get/put/del take the length
+// of a key written at its start in place of a key Buffer.
+const sharedKey = Buffer.from(binding.keyBuffer);
+
+// Like toKeyBuffer(), but writes string, number and ordered keys into the
+// shared key area and returns their length, so no Buffer is allocated.
+// Strings that might not fit still get a Buffer of their own.
+function toKeyArg(dbi, key) {
+  if (Buffer.isBuffer(key)) {
+    return key;
+  } else if (dbi._orderedKeys) {
+    return binding.encodeKey(key, sharedKey, 0);
+  } else if (typeof key === 'string' && key.length * 3 <= sharedKey.length) {
+    return sharedKey.write(key, 0);
+  } else if (typeof key === 'number') {
+    return sharedKey.writeBigInt64LE(BigInt(key), 0);
+  }
+  return ensureBuffer(key);
+}
+
+function fromKeyBuffer(dbi, buffer) {
+  return dbi._orderedKeys ? binding.decodeKey(buffer) : parseBuffer(buffer);
+}
+
+// Values of databases opened with valueEncoding: 'msgpack' go through the
+// native MessagePack codec. Buffers are taken as already encoded.
+function toValueBuffer(dbi, value) {
+  if (dbi._msgpackValues && !Buffer.isBuffer(value)) {
+    return binding.encodeValue(value);
+  }
+  return ensureValueBuffer(value);
+}
+
+// Like toValueBuffer(), but hands strings to the addon as they are; it
+// encodes them as UTF-8 straight into its own scratch memory.
+function toValueArg(dbi, value) {
+  if (typeof value === 'string' && !dbi._msgpackValues) {
+    return value;
+  }
+  return toValueBuffer(dbi, value);
+}
+
+// Records of a database with structures are decoded by the database itself,
+// reading unknown structures through `txn` when given
+function fromValueBuffer(dbi, buffer, txn) {
+  if (dbi._structures) {
+    return dbi._dbi.decode(buffer, txn ? txn._txn : undefined);
+  }
+  return dbi._msgpackValues ? binding.decodeValue(buffer) : parseBuffer(buffer);
+}
+
 function ensureValueBuffer(value) {
   if (Buffer.isBuffer(value)) {
     return value;
@@ -46,6 +107,41 @@ function ensureValueBuffer(value) {
   }
 }
 
+// Packs buffers into the length-prefixed format taken by the batch APIs:
+// each record is a uint32 LE byte length followed by the bytes
+function packRecords(records) {
+  let total = 0;
+  for (const record of records) {
+    total += 4 + record.length;
+  }
+
+  const packed = Buffer.allocUnsafe(total);
+  let offset = 0;
+  for (const record of records) {
+    offset = packed.writeUInt32LE(record.length, offset);
+    offset += record.copy(packed, offset);
+  }
+  return packed;
+}
+
+// Splits a packed buffer back into records. Missing records (length
+// 0xFFFFFFFF) come back as null; the others are views into `packed`.
+function unpackRecords(packed) {
+  const records = [];
+  let offset = 0;
+  while (offset < packed.length) {
+    const length = packed.readUInt32LE(offset);
+    offset += 4;
+    if (length === 0xFFFFFFFF) {
+      records.push(null);
+    } else {
+      records.push(packed.subarray(offset, offset + length));
+      offset += length;
+    }
+  }
+  return records;
+}
+
 // Try to parse a buffer as JSON, fall back to string if it fails
 function parseBuffer(buffer) {
   if (!buffer) return null;
@@ -83,10 +179,27 @@ class Environment {
     } catch (error) {
       throw new Error(`Failed to open environment: ${error.message}`);
     }
+
+    // Periodically clear reader slots of dead processes so they stop pinning
+    // old snapshots; the timer doesn't keep the process alive
+    if (opts.readerCheckInterval > 0) {
+      this._readerCheck = setInterval(() => {
+        try {
+          this._env.checkReaders();
+        } catch (error) {
+          // Retried on the next tick
+        }
+      }, opts.readerCheckInterval);
+      this._readerCheck.unref();
+    }
     return this;
   }
 
   close() {
+    if (this._readerCheck) {
+      clearInterval(this._readerCheck);
+      this._readerCheck = null;
+    }
     try {
       this._env.close();
     } catch (error) {
@@ -94,6 +207,14 @@ class Environment {
     }
   }
 
+  // Group-commit write queue, see Writer
+  get writer() {
+    if (!this._writer) {
+      this._writer = new Writer(this);
+    }
+    return this._writer;
+  }
+
   beginTransaction(options = {}) {
     const defaults = {
       mode: TransactionMode.READWRITE,
@@ -147,6 +268,60 @@ class Environment {
     }
   }
 
+  // Commit latency histograms per phase, shared by every Environment opened
+  // on this path. Adds percentile estimates taken from the bucket bounds.
+  commitStats(options = {}) {
+    let stats;
+    try {
+      stats = this._env.commitStats(options.reset === true);
+    } catch (error) {
+      throw new Error(`Failed to get commit stats: ${error.message}`);
+    }
+
+    for (const phase of Object.values(stats)) {
+      phase.meanUs = phase.count > 0 ? phase.totalUs / phase.count : 0;
+      for (const [name, p] of [['p50Us', 0.5], ['p99Us', 0.99], ['p999Us', 0.999]]) {
+        const rank = Math.ceil(p * phase.count);
+        let seen = 0;
+        let bucket = 0;
+        while (bucket < phase.buckets.length - 1 && seen + phase.buckets[bucket] < rank) {
+          seen += phase.buckets[bucket++];
+        }
+        phase[name] = phase.count > 0 ? Math.min(2 ** bucket, phase.maxUs) : 0;
+      }
+    }
+    return stats;
+  }
+
+  // Operation counters and sampled latency summaries, shared by every
+  // Environment opened on this path
+  metrics(options = {}) {
+    try {
+      return this._env.metrics(options.reset === true);
+    } catch (error) {
+      throw new Error(`Failed to get metrics: ${error.message}`);
+    }
+  }
+
+  // Occupied reader table slots, from every process using the environment
+  readers() {
+    try {
+      return this._env.readers();
+    } catch (error) {
+      throw new Error(`Failed to list readers: ${error.message}`);
+    }
+  }
+
+  // Clears reader slots of processes that died without releasing them.
+  // Returns the number cleared.
+  checkReaders() {
+    try {
+      return this._env.checkReaders();
+    } catch (error) {
+      throw new Error(`Failed to check readers: ${error.message}`);
+    }
+  }
+
   copy(path) {
     try {
       this._env.copy(path);
@@ -162,6 +337,122 @@ class Environment {
       throw new Error(`Failed to set map size: ${error.message}`);
     }
   }
+
+  // Async variants run a whole transaction on the libuv threadpool. A write
+  // waits for the environment's writer lock, so don't await one while this
+  // thread holds an open write transaction.
+  getAsync(dbi, key) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    let promise;
+    try {
+      const keyBuffer = toKeyBuffer(dbi, key);
+      promise = this._env.getAsync(dbi._dbi, keyBuffer);
+    } catch (error) {
+      throw new Error(`Failed to get value: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to get value: ${error.message}`);
+    });
+  }
+
+  putAsync(dbi, key, value, flags = 0) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    let promise;
+    try {
+      const keyBuffer = toKeyBuffer(dbi, key);
+      const valueBuffer = toValueBuffer(dbi, value);
+      promise = this._env.putAsync(dbi._dbi, keyBuffer, valueBuffer, flags);
+    } catch (error) {
+      throw new Error(`Failed to put value: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to put value: ${error.message}`);
+    });
+  }
+
+  delAsync(dbi, key, value = null) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    let promise;
+    try {
+      const keyBuffer = toKeyBuffer(dbi, key);
+      const valueBuffer = value !== null ? toValueBuffer(dbi, value) : null;
+      promise = this._env.delAsync(dbi._dbi, keyBuffer, valueBuffer);
+    } catch (error) {
+      throw new Error(`Failed to delete key: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to delete key: ${error.message}`);
+    });
+  }
+}
+
+// Writer class
+//
+// Queues puts and deletes for a native writer thread, which applies everything
+// queued since its last commit in a single write transaction. Each returned
+// promise settles once the batch containing it has been committed, so many
+// concurrent writes share one fsync.
+class Writer {
+  constructor(env) {
+    this._env = env;
+  }
+
+  put(dbi, key, value, flags = 0) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    let promise;
+    try {
+      const keyBuffer = toKeyBuffer(dbi, key);
+      const valueBuffer = toValueBuffer(dbi, value);
+      promise = this._env._env.writerPut(dbi._dbi, keyBuffer, valueBuffer, flags);
+    } catch (error) {
+      throw new Error(`Failed to put value: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to put value: ${error.message}`);
+    });
+  }
+
+  del(dbi, key, value = null) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    let promise;
+    try {
+      const keyBuffer = toKeyBuffer(dbi, key);
+      const valueBuffer = value !== null ? toValueBuffer(dbi, value) : null;
+      promise = this._env._env.writerDel(dbi._dbi, keyBuffer, valueBuffer);
+    } catch (error) {
+      throw new Error(`Failed to delete key: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to delete key: ${error.message}`);
+    });
+  }
+
+  flush() {
+    let promise;
+    try {
+      promise = this._env._env.writerFlush();
+    } catch (error) {
+      throw new Error(`Failed to flush writer: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to flush writer: ${error.message}`);
+    });
+  }
 }
 
 // Transaction class
@@ -193,14 +484,30 @@ class Transaction {
     }
   }
 
+  // Returns how long each phase of a write transaction's commit took, in
+  // microseconds; see Environment.commitStats()
   commit() {
     try {
-      this._txn.commit();
+      return this._txn.commit();
     } catch (error) {
       throw new Error(`Failed to commit transaction: ${error.message}`);
     }
   }
 
+  // Resolves once the commit is durable, with the fsync run on the
+  // threadpool. Write transactions must be begun with asyncCommit: true.
+  commitAsync() {
+    let promise;
+    try {
+      promise = this._txn.commitAsync();
+    } catch (error) {
+      throw new Error(`Failed to commit transaction: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to sync transaction: ${error.message}`);
+    });
+  }
+
   renew() {
     try {
       this._txn.renew();
@@ -223,37 +530,149 @@ class Transaction {
     }
     
     try {
-      const keyBuffer = ensureBuffer(key);
-      const result = this._txn.get(dbi._dbi, keyBuffer);
+      const result = this._txn.get(dbi._dbi, toKeyArg(dbi, key));
       return result;
     } catch (error) {
       throw new Error(`Failed to get value: ${error.message}`);
     }
   }
 
+  // Reads a value as a UTF-8 string, built natively from the stored bytes
+  // without an intermediate Buffer. Returns null when the key is missing.
+  getString(dbi, key) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      return this._txn.getString(dbi._dbi, toKeyArg(dbi, key));
+    } catch (error) {
+      throw new Error(`Failed to get value: ${error.message}`);
+    }
+  }
+
+  // Copies a value into `target` (a Buffer or ArrayBuffer) at `offset`, so
+  // reads can reuse one buffer. Returns the value's length, its negated
+  // length when it doesn't fit (nothing is copied), or null when missing.
+  getInto(dbi, key, target, offset = 0) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      return this._txn.getInto(dbi._dbi, toKeyArg(dbi, key), target, offset);
+    } catch (error) {
+      throw new Error(`Failed to get value: ${error.message}`);
+    }
+  }
+
+  // Reads a MessagePack value and decodes it natively, straight from the
+  // memory map. Returns undefined when the key is missing.
+  getDecoded(dbi, key) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      return this._txn.getDecoded(dbi._dbi, toKeyArg(dbi, key));
+    } catch (error) {
+      throw new Error(`Failed to get value: ${error.message}`);
+    }
+  }
+
+  // Encodes `value` as MessagePack natively and stores it
+  putEncoded(dbi, key, value, flags = 0) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      this._txn.putEncoded(dbi._dbi, toKeyArg(dbi, key), value, flags);
+    } catch (error) {
+      throw new Error(`Failed to put value: ${error.message}`);
+    }
+  }
+
+  // Looks up many keys in one native call. Takes an array of keys, returning
+  // an array of values (null when missing), or a buffer built with
+  // packRecords(), returning the values packed the same way.
+  getMany(dbi, keys) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      const keyBuffers = Buffer.isBuffer(keys) ? keys : keys.map((key) => toKeyBuffer(dbi, key));
+      return this._txn.getMany(dbi._dbi, keyBuffers);
+    } catch (error) {
+      throw new Error(`Failed to get values: ${error.message}`);
+    }
+  }
+
+  // Only available for read-only transactions of an environment opened with
+  // EnvFlags.NOTLS; other transactions are bound to the thread that began them.
+  getAsync(dbi, key) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    let promise;
+    try {
+      const keyBuffer = toKeyBuffer(dbi, key);
+      promise = this._txn.getAsync(dbi._dbi, keyBuffer);
+    } catch (error) {
+      throw new Error(`Failed to get value: ${error.message}`);
+    }
+    return promise.catch((error) => {
+      throw new Error(`Failed to get value: ${error.message}`);
+    });
+  }
+
   put(dbi, key, value, flags = 0) {
     if (!(dbi instanceof Database)) {
       throw new Error('First argument must be a Database instance');
     }
     
     try {
-      const keyBuffer = ensureBuffer(key);
-      const valueBuffer = ensureValueBuffer(value);
-      this._txn.put(dbi._dbi, keyBuffer, valueBuffer, flags);
+      if (dbi._msgpackValues && !Buffer.isBuffer(value)) {
+        this._txn.putEncoded(dbi._dbi, toKeyArg(dbi, key), value, flags);
+        return;
+      }
+      // The value is converted first, since toJSON() may use the key area
+      const valueArg = toValueArg(dbi, value);
+      this._txn.put(dbi._dbi, toKeyArg(dbi, key), valueArg, flags);
     } catch (error) {
       throw new Error(`Failed to put value: ${error.message}`);
     }
   }
 
+  // Writes many records in one native call through a single cursor. Takes
+  // either a buffer built with packRecords([key1, value1, key2, value2...])
+  // or separate arrays of keys and values. Returns the number of records
+  // written; those rejected by NOOVERWRITE or NODUPDATA are skipped.
+  putMany(dbi, keys, values, flags = 0) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      if (Buffer.isBuffer(keys)) {
+        return this._txn.putMany(dbi._dbi, keys, typeof values === 'number' ? values : flags);
+      }
+      return this._txn.putMany(dbi._dbi, keys.map((key) => toKeyBuffer(dbi, key)), values.map((value) => toValueBuffer(dbi, value)), flags);
+    } catch (error) {
+      throw new Error(`Failed to put values: ${error.message}`);
+    }
+  }
+
   del(dbi, key, value = null) {
     if (!(dbi instanceof Database)) {
       throw new Error('First argument must be a Database instance');
     }
     
     try {
-      const keyBuffer = ensureBuffer(key);
-      const valueBuffer = value !== null ? ensureValueBuffer(value) : null;
-      return this._txn.del(dbi._dbi, keyBuffer, valueBuffer);
+      const valueBuffer = value !== null ? toValueBuffer(dbi, value) : null;
+      return this._txn.del(dbi._dbi, toKeyArg(dbi, key), valueBuffer);
     } catch (error) {
       throw new Error(`Failed to delete key: ${error.message}`);
     }
@@ -270,6 +689,20 @@ class Transaction {
       throw new Error(`Failed to open cursor: ${error.message}`);
     }
   }
+
+  // Returns the native handle as is: its get/put/del take Buffers only and
+  // skip the key and value encodings of the database
+  bind(dbi) {
+    if (!(dbi instanceof Database)) {
+      throw new Error('First argument must be a Database instance');
+    }
+
+    try {
+      return this._txn.bind(dbi._dbi);
+    } catch (error) {
+      throw new Error(`Failed to bind transaction: ${error.message}`);
+    }
+  }
 }
 
 // Database class
@@ -286,9 +719,22 @@ class Database {
     };
 
     const opts = { ...defaults, ...options };
+    if (opts.keyEncoding !== undefined && opts.keyEncoding !== 'binary' && opts.keyEncoding !== 'ordered') {
+      throw new Error(`Unsupported key encoding: ${opts.keyEncoding}`);
+    }
+    if (opts.valueEncoding !== undefined && opts.valueEncoding !== 'json' && opts.valueEncoding !== 'msgpack') {
+      throw new Error(`Unsupported value encoding: ${opts.valueEncoding}`);
+    }
+    if (opts.structures && opts.valueEncoding !== 'msgpack') {
+      throw new Error('Record structures require valueEncoding: \'msgpack\'');
+    }
+
     try {
       this._dbi = new binding.Database(env._env, opts);
       this._env = env;
+      this._orderedKeys = opts.keyEncoding === 'ordered';
+      this._msgpackValues = opts.valueEncoding === 'msgpack';
+      this._structures = Boolean(opts.structures);
     } catch (error) {
       throw new Error(`Failed to create database: ${error.message}`);
     }
@@ -310,6 +756,30 @@ class Database {
     }
   }
 
+  // Empties the database inside `txn`, freeing its pages wholesale; unlike
+  // drop() the handle stays open
+  truncate(txn) {
+    if (!(txn instanceof Transaction)) {
+      throw new Error('First argument must be a Transaction instance');
+    }
+
+    try {
+      this._dbi.truncate(txn._txn);
+    } catch (error) {
+      throw new Error(`Failed to truncate database: ${error.message}`);
+    }
+  }
+
+  // Trains a compression dictionary from the database's current values in
+  // its own write transaction; later writes are compressed against it
+  trainDictionary(options = {}) {
+    try {
+      return this._dbi.trainDictionary(options);
+    } catch (error) {
+      throw new Error(`Failed to train dictionary: ${error.message}`);
+    }
+  }
+
   stat(txn) {
     if (!(txn instanceof Transaction)) {
       throw new Error('First argument must be a Transaction instance');
@@ -360,8 +830,8 @@ class Cursor {
 
   get(op, key = null, value = null) {
     try {
-      const keyBuffer = key !== null ? ensureBuffer(key) : null;
-      const valueBuffer = value !== null ? ensureValueBuffer(value) : null;
+      const keyBuffer = key !== null ? toKeyBuffer(this._dbi, key) : null;
+      const valueBuffer = value !== null ? toValueBuffer(this._dbi, value) : null;
       return this._cursor.get(op, keyBuffer, valueBuffer);
     } catch (error) {
       throw new Error(`Failed to get cursor position: ${error.message}`);
@@ -370,14 +840,54 @@ class Cursor {
 
   put(key, value, flags = 0) {
     try {
-      const keyBuffer = ensureBuffer(key);
-      const valueBuffer = ensureValueBuffer(value);
-      this._cursor.put(keyBuffer, valueBuffer, flags);
+      const keyBuffer = toKeyBuffer(this._dbi, key);
+      const valueArg = toValueArg(this._dbi, value);
+      this._cursor.put(keyBuffer, valueArg, flags);
     } catch (error) {
       throw new Error(`Failed to put key-value pair: ${error.message}`);
     }
   }
 
+  // Reads every record between `start` and `end` (in key order, whatever the
+  // direction) in one native call. Returns the pairs as a packed buffer of
+  // alternating keys and values; see unpackRecords().
+  getRange(options = {}) {
+    try {
+      const opts = { ...options };
+      if (opts.start !== undefined && opts.start !== null) opts.start = toKeyBuffer(this._dbi, opts.start);
+      if (opts.end !== undefined && opts.end !== null) opts.end = toKeyBuffer(this._dbi, opts.end);
+      return this._cursor.getRange(opts);
+    } catch (error) {
+      throw new Error(`Failed to get range: ${error.message}`);
+    }
+  }
+
+  // Counts the records of a range natively, taking the same options as
+  // getRange()
+  countRange(options = {}) {
+    try {
+      const opts = { ...options };
+      if (opts.start !== undefined && opts.start !== null) opts.start = toKeyBuffer(this._dbi, opts.start);
+      if (opts.end !== undefined && opts.end !== null) opts.end = toKeyBuffer(this._dbi, opts.end);
+      return this._cursor.countRange(opts);
+    } catch (error) {
+      throw new Error(`Failed to count range: ${error.message}`);
+    }
+  }
+
+  // Deletes the records of a range natively, taking the same options as
+  // getRange(). Returns the number of records deleted.
+  deleteRange(options = {}) {
+    try {
+      const opts = { ...options };
+      if (opts.start !== undefined && opts.start !== null) opts.start = toKeyBuffer(this._dbi, opts.start);
+      if (opts.end !== undefined && opts.end !== null) opts.end = toKeyBuffer(this._dbi, opts.end);
+      return this._cursor.deleteRange(opts);
+    } catch (error) {
+      throw new Error(`Failed to delete range: ${error.message}`);
+    }
+  }
+
   count() {
     try {
       return this._cursor.count();
@@ -403,8 +913,14 @@ function collection(env, name = null, options = {}) {
     get(key, txnOptions = {}) {
       const txn = env.beginTransaction({ mode: TransactionMode.READONLY, ...txnOptions });
       try {
-        const buffer = txn.get(db, key);
-        const result = buffer ? parseBuffer(buffer) : null;
+        let result;
+        if (db._msgpackValues) {
+          result = txn.getDecoded(db, key);
+          if (result === undefined) result = null;
+        } else {
+          const buffer = txn.get(db, key);
+          result = buffer ? fromValueBuffer(db, buffer) : null;
+        }
         txn.abort();
         return result;
       } catch (error) {
@@ -413,6 +929,32 @@ function collection(env, name = null, options = {}) {
       }
     },
 
+    getMany(keys, txnOptions = {}) {
+      const txn = env.beginTransaction({ mode: TransactionMode.READONLY, ...txnOptions });
+      try {
+        const results = txn.getMany(db, keys).map((buffer) => buffer ? fromValueBuffer(db, buffer, txn) : null);
+        txn.abort();
+        return results;
+      } catch (error) {
+        txn.abort();
+        throw error;
+      }
+    },
+
+    async getAsync(key) {
+      const buffer = await env.getAsync(db, key);
+      return buffer ? fromValueBuffer(db, buffer) : null;
+    },
+
+    // Async writes go through the environment's group-commit writer
+    putAsync(key, value) {
+      return env.writer.put(db, key, value);
+    },
+
+    delAsync(key) {
+      return env.writer.del(db, key);
+    },
+
     put(key, value, txnOptions = {}) {
       const txn = env.beginTransaction(txnOptions);
       try {
@@ -424,6 +966,19 @@ function collection(env, name = null, options = {}) {
       }
     },
 
+    // Writes an array of [key, value] pairs in one transaction
+    putMany(entries, txnOptions = {}) {
+      const txn = env.beginTransaction(txnOptions);
+      try {
+        const result = txn.putMany(db, entries.map((entry) => entry[0]), entries.map((entry) => entry[1]));
+        txn.commit();
+        return result;
+      } catch (error) {
+        txn.abort();
+        throw error;
+      }
+    },
+
     del(key, txnOptions = {}) {
       const txn = env.beginTransaction(txnOptions);
       try {
@@ -443,72 +998,26 @@ function collection(env, name = null, options = {}) {
       const results = [];
 
       try {
-        let found = false;
-        
-        // Set initial position based on options
-        if (reverse) {
-          if (lte) {
-            const keyBuffer = ensureBuffer(lte);
-            found = !!cursor.get(SeekOperation.SET_RANGE, keyBuffer);
-            if (!found) {
-              found = !!cursor.get(SeekOperation.LAST);
-            }
-          } else if (lt) {
-            const keyBuffer = ensureBuffer(lt);
-            found = !!cursor.get(SeekOperation.SET_RANGE, keyBuffer);
-            if (found) {
-              // Move one step back since lt is exclusive
-              found = !!cursor.get(SeekOperation.PREV);
-            } else {
-              found = !!cursor.get(SeekOperation.LAST);
-            }
-          } else {
-            found = !!cursor.get(SeekOperation.LAST);
-          }
-        } else {
-          if (gte) {
-            const keyBuffer = ensureBuffer(gte);
-            found = !!cursor.get(SeekOperation.SET_RANGE, keyBuffer);
-          } else if (gt) {
-            const keyBuffer = ensureBuffer(gt);
-            found = !!cursor.get(SeekOperation.SET_RANGE, keyBuffer);
-            if (found) {
-              const currentKey = cursor.get(SeekOperation.GET_CURRENT).key.toString();
-              if (currentKey === keyBuffer.toString()) {
-                // Skip this key since gt is exclusive
-                found = !!cursor.get(SeekOperation.NEXT);
-              }
-            }
-          } else {
-            found = !!cursor.get(SeekOperation.FIRST);
-          }
+        const range = { limit, reverse };
+        if (gte !== undefined && gte !== null) {
+          range.start = gte;
+        } else if (gt !== undefined && gt !== null) {
+          range.start = gt;
+          range.exclusiveStart = true;
+        }
+        if (lte !== undefined && lte !== null) {
+          range.end = lte;
+          range.inclusiveEnd = true;
+        } else if (lt !== undefined && lt !== null) {
+          range.end = lt;
         }
 
-        // Collect results
-        let count = 0;
-        while (found && count < limit) {
-          const kv = cursor.get(SeekOperation.GET_CURRENT);
-          if (!kv) break;
-
-          const keyStr = kv.key.toString();
-
-          // Check upper bound
-          if (!reverse && lt && keyStr >= ensureBuffer(lt).toString()) break;
-          if (!reverse && lte && keyStr > ensureBuffer(lte).toString()) break;
-
-          // Check lower bound
-          if (reverse && gt && keyStr <= ensureBuffer(gt).toString()) break;
-          if (reverse && gte && keyStr < ensureBuffer(gte).toString()) break;
-
+        const records = unpackRecords(cursor.getRange(range));
+        for (let i = 0; i < records.length; i += 2) {
           results.push({
-            key: parseBuffer(kv.key),
-            value: parseBuffer(kv.value)
+            key: fromKeyBuffer(db, records[i]),
+            value: fromValueBuffer(db, records[i + 1], txn)
           });
-          
-          count++;
-          found = reverse ? 
-            !!cursor.get(SeekOperation.PREV) : 
-            !!cursor.get(SeekOperation.NEXT);
         }
 
         cursor.close();
@@ -521,18 +1030,25 @@ function collection(env, name = null, options = {}) {
       }
     },
 
+    // The entry count is kept in the b-tree's own statistics
     count(txnOptions = {}) {
+      const txn = env.beginTransaction({ mode: TransactionMode.READONLY, ...txnOptions });
+      try {
+        const count = db.stat(txn).entries;
+        txn.abort();
+        return count;
+      } catch (error) {
+        txn.abort();
+        throw error;
+      }
+    },
+
+    // Exact number of keys k with gte <= k < lt; either bound may be omitted
+    countRange(gte, lt, txnOptions = {}) {
       const txn = env.beginTransaction({ mode: TransactionMode.READONLY, ...txnOptions });
       try {
         const cursor = txn.openCursor(db);
-        let count = 0;
-        let found = !!cursor.get(SeekOperation.FIRST);
-        
-        while (found) {
-          count++;
-          found = !!cursor.get(SeekOperation.NEXT);
-        }
-        
+        const count = cursor.countRange({ start: gte, end: lt });
         cursor.close();
         txn.abort();
         return count;
@@ -546,19 +1062,26 @@ function collection(env, name = null, options = {}) {
       db.drop();
     },
 
-    clear() {
-      const txn = env.beginTransaction();
+    // Deletes keys k with gte <= k < lt; either bound may be omitted
+    deleteRange(gte, lt, txnOptions = {}) {
+      const txn = env.beginTransaction(txnOptions);
       try {
         const cursor = txn.openCursor(db);
-        let found = !!cursor.get(SeekOperation.FIRST);
-        
-        while (found) {
-          cursor.del();
-          found = !!cursor.get(SeekOperation.NEXT);
-        }
-        
+        const count = cursor.deleteRange({ start: gte, end: lt });
         cursor.close();
         txn.commit();
+        return count;
+      } catch (error) {
+        txn.abort();
+        throw error;
+      }
+    },
+
+    clear() {
+      const txn = env.beginTransaction();
+      try {
+        db.truncate(txn);
+        txn.commit();
       } catch (error) {
         txn.abort();
         throw error;
@@ -571,13 +1094,22 @@ function collection(env, name = null, options = {}) {
 module.exports = {
   Environment,
   Transaction,
+  Writer,
   Database,
   Cursor,
   EnvFlags,
   DatabaseFlags,
   WriteFlags,
   TransactionMode,
+  TxnFlags,
   SeekOperation,
   open,
-  collection
+  collection,
+  packRecords,
+  unpackRecords,
+  encodeKey: binding.encodeKey,
+  decodeKey: binding.decodeKey,
+  encodeValue: binding.encodeValue,
+  decodeValue: binding.decodeValue,
+  keyBuffer: sharedKey
 };
\ No newline at end of file
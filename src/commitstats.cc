@@ -0,0 +1,69 @@
+#include "commitstats.h"
+#include "env.h"
+
+const char* const MdbxCommitStats::kPhaseNames[PHASES] = {
+  "preparation", "gc", "audit", "write", "sync", "ending", "whole"
+};
+
+int MdbxCommitStats::Commit(MDBX_txn* txn, MDBX_commit_latency* latency) {
+  // The transaction is freed by the commit, so look up its environment first
+  MDBX_env* env = mdbx_txn_env(txn);
+  bool isWrite = !(static_cast<unsigned>(mdbx_txn_flags(txn)) & MDBX_TXN_RDONLY);
+
+  MDBX_commit_latency local;
+  MDBX_commit_latency* out = latency ? latency : &local;
+  int rc = mdbx_txn_commit_ex(txn, out);
+
+  MdbxSharedEnv* shared = env ? static_cast<MdbxSharedEnv*>(mdbx_env_get_userctx(env)) : nullptr;
+  if (rc == MDBX_SUCCESS && isWrite && shared) {
+    shared->commitStats.Record(*out);
+    shared->metrics.Record(MdbxMetrics::COMMIT, static_cast<uint64_t>(Micros(out->whole) * 1000));
+  }
+  return rc;
+}
+
+void MdbxCommitStats::Record(const MDBX_commit_latency& latency) {
+  const uint32_t units[PHASES] = {
+    latency.preparation, latency.gc, latency.audit, latency.write,
+    latency.sync, latency.ending, latency.whole
+  };
+
+  for (int phase = 0; phase < PHASES; phase++) {
+    uint64_t us = static_cast<uint64_t>(Micros(units[phase]));
+    int bucket = 0;
+    while (bucket < kBuckets - 1 && (uint64_t(1) << bucket) <= us) {
+      bucket++;
+    }
+
+    Counters& counters = phases_[phase];
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.totalUs.fetch_add(us, std::memory_order_relaxed);
+    counters.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = counters.maxUs.load(std::memory_order_relaxed);
+    while (us > max && !counters.maxUs.compare_exchange_weak(max, us, std::memory_order_relaxed)) {
+    }
+  }
+}
+
+MdbxCommitStats::Histogram MdbxCommitStats::Read(Phase phase) const {
+  const Counters& counters = phases_[phase];
+  Histogram histogram;
+  histogram.count = counters.count.load(std::memory_order_relaxed);
+  histogram.totalUs = counters.totalUs.load(std::memory_order_relaxed);
+  histogram.maxUs = counters.maxUs.load(std::memory_order_relaxed);
+  for (int i = 0; i < kBuckets; i++) {
+    histogram.buckets[i] = counters.buckets[i].load(std::memory_order_relaxed);
+  }
+  return histogram;
+}
+
+void MdbxCommitStats::Reset() {
+  for (Counters& counters : phases_) {
+    counters.count.store(0, std::memory_order_relaxed);
+    counters.totalUs.store(0, std::memory_order_relaxed);
+    counters.maxUs.store(0, std::memory_order_relaxed);
+    for (std::atomic<uint64_t>& bucket : counters.buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+}
\ No newline at end of file
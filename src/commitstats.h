@@ -0,0 +1,50 @@
+#ifndef MDBX_COMMITSTATS_H
+#define MDBX_COMMITSTATS_H
+
+#include <atomic>
+#include <cstdint>
+#include "mdbx_wrapper.h"
+
+// Commit latency histograms of one shared environment, one per phase that
+// mdbx_txn_commit_ex() reports. Write transactions are committed on JS
+// threads, the writer thread and the threadpool, so every counter is an
+// atomic updated without a lock.
+class MdbxCommitStats {
+ public:
+  enum Phase { PREPARATION, GC, AUDIT, WRITE, SYNC, ENDING, WHOLE, PHASES };
+  static const char* const kPhaseNames[PHASES];
+  // Bucket i counts durations below 2^i microseconds (and at least 2^(i-1)),
+  // the last one everything longer
+  static const int kBuckets = 32;
+
+  struct Histogram {
+    uint64_t count = 0;
+    uint64_t totalUs = 0;
+    uint64_t maxUs = 0;
+    uint64_t buckets[kBuckets] = {};
+  };
+
+  // Commits `txn` with mdbx_txn_commit_ex(), adding the latency of a
+  // successful write transaction to the stats of its environment. `latency`
+  // receives the breakdown when not null.
+  static int Commit(MDBX_txn* txn, MDBX_commit_latency* latency = nullptr);
+
+  // libmdbx reports durations in 1/65536 of a second
+  static double Micros(uint32_t units) { return units * (1000000.0 / 65536.0); }
+
+  void Record(const MDBX_commit_latency& latency);
+  Histogram Read(Phase phase) const;
+  void Reset();
+
+ private:
+  struct Counters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalUs{0};
+    std::atomic<uint64_t> maxUs{0};
+    std::atomic<uint64_t> buckets[kBuckets] = {};
+  };
+
+  Counters phases_[PHASES];
+};
+
+#endif // MDBX_COMMITSTATS_H
\ No newline at end of file
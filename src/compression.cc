@@ -0,0 +1,311 @@
+#include "compression.h"
+#include "lz4.h"
+#include <cstring>
+#include <vector>
+
+const char* const MdbxCompression::STORE_NAME = "__mdbxjs_dictionaries";
+
+enum CompressionTag : unsigned char {
+  TAG_RAW = 0,
+  TAG_LZ4 = 1,
+  TAG_LZ4_DICT = 2
+};
+
+// Refuse to inflate corrupt values into absurd allocations
+static const uint32_t kMaxValueLength = 0x7FFFFFFF;
+
+static void AppendU32(std::string& out, uint32_t v) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<char>(v >> shift));
+  }
+}
+
+static uint32_t ReadU32(const unsigned char* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+         (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// FNV-1a, naming dictionaries by their content
+static uint32_t ContentId(const std::string& data) {
+  uint32_t hash = 2166136261u;
+  for (unsigned char c : data) {
+    hash = (hash ^ c) * 16777619u;
+  }
+  return hash;
+}
+
+MdbxCompression::MdbxCompression(MDBX_dbi store, const std::string& owner, size_t threshold)
+  : store_(store), owner_(owner), threshold_(threshold) {}
+
+std::string MdbxCompression::StoreKey(const std::string& owner, char kind, uint32_t id) {
+  std::string key = owner;
+  key.push_back('\0');
+  key.push_back(kind);
+  if (kind == 'd') {
+    for (int shift = 24; shift >= 0; shift -= 8) {
+      key.push_back(static_cast<char>(id >> shift));
+    }
+  }
+  return key;
+}
+
+int MdbxCompression::LoadDictionary(MDBX_txn* txn, uint32_t id, Dictionary& dictionary) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = dictionaries_.find(id);
+    if (found != dictionaries_.end()) {
+      dictionary = found->second;
+      return MDBX_SUCCESS;
+    }
+  }
+
+  std::string storeKey = StoreKey('d', id);
+  MDBX_val key, data;
+  key.iov_base = &storeKey[0];
+  key.iov_len = storeKey.size();
+  int rc = mdbx_get(txn, store_, &key, &data);
+  if (rc != MDBX_SUCCESS) {
+    return rc == MDBX_NOTFOUND ? MDBX_CORRUPTED : rc;
+  }
+
+  dictionary = std::make_shared<const std::string>(static_cast<const char*>(data.iov_base), data.iov_len);
+  std::lock_guard<std::mutex> lock(mutex_);
+  dictionaries_[id] = dictionary;
+  return MDBX_SUCCESS;
+}
+
+int MdbxCompression::IsMarked(MDBX_txn* txn, MDBX_dbi store, const std::string& owner, bool& marked) {
+  std::string storeKey = StoreKey(owner, 'm', 0);
+  MDBX_val key, data;
+  key.iov_base = &storeKey[0];
+  key.iov_len = storeKey.size();
+  int rc = mdbx_get(txn, store, &key, &data);
+  marked = rc == MDBX_SUCCESS;
+  return rc == MDBX_NOTFOUND ? MDBX_SUCCESS : rc;
+}
+
+int MdbxCompression::Open(MDBX_txn* txn, MDBX_dbi dbi) {
+  bool marked;
+  int rc = IsMarked(txn, store_, owner_, marked);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+  if (!marked) {
+    MDBX_stat stat;
+    rc = mdbx_dbi_stat(txn, dbi, &stat, sizeof(stat));
+    if (rc != MDBX_SUCCESS) {
+      return rc;
+    } else if (stat.ms_entries > 0) {
+      return MDBX_INCOMPATIBLE;
+    }
+
+    std::string markerKey = StoreKey('m', 0);
+    MDBX_val key, data;
+    key.iov_base = &markerKey[0];
+    key.iov_len = markerKey.size();
+    char version = 1;
+    data.iov_base = &version;
+    data.iov_len = 1;
+    rc = mdbx_put(txn, store_, &key, &data, MDBX_UPSERT);
+    if (rc != MDBX_SUCCESS) {
+      return rc;
+    }
+  }
+
+  std::string storeKey = StoreKey('c', 0);
+  MDBX_val key, data;
+  key.iov_base = &storeKey[0];
+  key.iov_len = storeKey.size();
+  rc = mdbx_get(txn, store_, &key, &data);
+  if (rc == MDBX_NOTFOUND) {
+    return MDBX_SUCCESS;
+  } else if (rc != MDBX_SUCCESS) {
+    return rc;
+  } else if (data.iov_len != 4) {
+    return MDBX_CORRUPTED;
+  }
+
+  uint32_t id = ReadU32(static_cast<const unsigned char*>(data.iov_base));
+  Dictionary dictionary;
+  rc = LoadDictionary(txn, id, dictionary);
+  if (rc == MDBX_SUCCESS) {
+    currentId_ = id;
+    current_ = dictionary;
+  }
+  return rc;
+}
+
+int MdbxCompression::Forget(MDBX_txn* txn) {
+  MDBX_cursor* cursor;
+  int rc = mdbx_cursor_open(txn, store_, &cursor);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  std::string prefix = owner_;
+  prefix.push_back('\0');
+  // Seeks again after each delete rather than relying on where it leaves
+  // the cursor
+  for (;;) {
+    MDBX_val key, data;
+    key.iov_base = &prefix[0];
+    key.iov_len = prefix.size();
+    rc = mdbx_cursor_get(cursor, &key, &data, MDBX_SET_RANGE);
+    if (rc != MDBX_SUCCESS || key.iov_len <= prefix.size() ||
+        std::memcmp(key.iov_base, prefix.data(), prefix.size()) != 0) {
+      break;
+    }
+    rc = mdbx_cursor_del(cursor, static_cast<MDBX_put_flags_t>(0));
+    if (rc != MDBX_SUCCESS) {
+      break;
+    }
+  }
+  mdbx_cursor_close(cursor);
+  return rc == MDBX_NOTFOUND || rc == MDBX_SUCCESS ? MDBX_SUCCESS : rc;
+}
+
+void MdbxCompression::SetCurrent(uint32_t id, const Dictionary& dictionary) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dictionaries_[id] = dictionary;
+  }
+  currentId_ = id;
+  current_ = dictionary;
+}
+
+void MdbxCompression::Compress(const MDBX_val& value, std::string& out) {
+  out.clear();
+  const char* src = static_cast<const char*>(value.iov_base);
+
+  if (value.iov_len >= threshold_ && value.iov_len > 16 && value.iov_len <= kMaxValueLength) {
+    out.push_back(static_cast<char>(current_ ? TAG_LZ4_DICT : TAG_LZ4));
+    if (current_) {
+      AppendU32(out, currentId_);
+    }
+    AppendU32(out, static_cast<uint32_t>(value.iov_len));
+
+    // Only worth it when the block is smaller than the value plus its header
+    size_t header = out.size();
+    out.resize(header + value.iov_len);
+    size_t compressed = Lz4::Compress(src, value.iov_len, &out[header], value.iov_len - header,
+                                      current_ ? current_->data() : nullptr, current_ ? current_->size() : 0);
+    if (compressed > 0) {
+      out.resize(header + compressed);
+      return;
+    }
+    out.clear();
+  }
+
+  out.reserve(value.iov_len + 1);
+  out.push_back(static_cast<char>(TAG_RAW));
+  out.append(src, value.iov_len);
+}
+
+int MdbxCompression::Decompress(MDBX_txn* txn, const MDBX_val& in, MDBX_val& out, std::string& scratch) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(in.iov_base);
+  if (in.iov_len == 0) {
+    return MDBX_CORRUPTED;
+  }
+
+  if (bytes[0] == TAG_RAW) {
+    out.iov_base = const_cast<unsigned char*>(bytes + 1);
+    out.iov_len = in.iov_len - 1;
+    return MDBX_SUCCESS;
+  }
+
+  size_t header = bytes[0] == TAG_LZ4_DICT ? 9 : 5;
+  if ((bytes[0] != TAG_LZ4 && bytes[0] != TAG_LZ4_DICT) || in.iov_len < header) {
+    return MDBX_CORRUPTED;
+  }
+
+  Dictionary dictionary;
+  if (bytes[0] == TAG_LZ4_DICT) {
+    int rc = LoadDictionary(txn, ReadU32(bytes + 1), dictionary);
+    if (rc != MDBX_SUCCESS) {
+      return rc;
+    }
+  }
+
+  uint32_t length = ReadU32(bytes + header - 4);
+  if (length > kMaxValueLength) {
+    return MDBX_CORRUPTED;
+  }
+  scratch.resize(length);
+  if (!Lz4::Decompress(reinterpret_cast<const char*>(bytes + header), in.iov_len - header, &scratch[0], length,
+                       dictionary ? dictionary->data() : nullptr, dictionary ? dictionary->size() : 0)) {
+    return MDBX_CORRUPTED;
+  }
+  out.iov_base = &scratch[0];
+  out.iov_len = length;
+  return MDBX_SUCCESS;
+}
+
+int MdbxCompression::Train(MDBX_txn* txn, MDBX_dbi dbi, size_t samples, size_t maxSize,
+                           uint32_t& id, Dictionary& dictionary) {
+  dictionary.reset();
+  MDBX_cursor* cursor;
+  int rc = mdbx_cursor_open(txn, dbi, &cursor);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  // Samples are the values themselves, so compressed ones are expanded first
+  std::vector<std::string> values;
+  MDBX_val key, data, value;
+  std::string scratch;
+  rc = mdbx_cursor_get(cursor, &key, &data, MDBX_FIRST);
+  while (rc == MDBX_SUCCESS && values.size() < samples) {
+    rc = Decompress(txn, data, value, scratch);
+    if (rc != MDBX_SUCCESS) {
+      break;
+    }
+    values.emplace_back(static_cast<const char*>(value.iov_base), value.iov_len);
+    rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT);
+  }
+  mdbx_cursor_close(cursor);
+  if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+    return rc;
+  }
+
+  Dictionary trained = std::make_shared<const std::string>(Lz4::TrainDictionary(values, maxSize));
+  if (trained->empty()) {
+    return MDBX_SUCCESS;
+  }
+
+  // An id already naming other bytes is never overwritten, so in the
+  // unlikely case of a hash collision the next free id is taken
+  std::string dictKey;
+  for (id = ContentId(*trained);; id++) {
+    dictKey = StoreKey('d', id);
+    key.iov_base = &dictKey[0];
+    key.iov_len = dictKey.size();
+    data.iov_base = const_cast<char*>(trained->data());
+    data.iov_len = trained->size();
+    rc = mdbx_put(txn, store_, &key, &data, MDBX_NOOVERWRITE);
+    if (rc == MDBX_KEYEXIST && data.iov_len == trained->size() &&
+        std::memcmp(data.iov_base, trained->data(), data.iov_len) == 0) {
+      rc = MDBX_SUCCESS;
+    }
+    if (rc != MDBX_KEYEXIST) {
+      break;
+    }
+  }
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  std::string currentKey = StoreKey('c', 0);
+  std::string currentId;
+  AppendU32(currentId, id);
+  key.iov_base = &currentKey[0];
+  key.iov_len = currentKey.size();
+  data.iov_base = &currentId[0];
+  data.iov_len = currentId.size();
+  rc = mdbx_put(txn, store_, &key, &data, MDBX_UPSERT);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  dictionary = trained;
+  return MDBX_SUCCESS;
+}
\ No newline at end of file
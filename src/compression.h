@@ -0,0 +1,77 @@
+#ifndef MDBX_COMPRESSION_H
+#define MDBX_COMPRESSION_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "mdbx_wrapper.h"
+
+// Value compression of one database. Every stored value starts with a tag:
+//
+//   0  raw          the value follows as is
+//   1  LZ4          uint32 LE length, then an LZ4 block
+//   2  LZ4 + dict   uint32 LE dictionary id, uint32 LE length, then an LZ4
+//                   block compressed against that dictionary
+//
+// Values shorter than the threshold, or that don't shrink, are stored raw.
+// Dictionaries are kept in the reserved STORE_NAME table, keyed by the owning
+// database's name and content hash, so a dictionary id always names the same
+// bytes and cached dictionaries never go stale. The same table holds a marker
+// per compressed database, so opening it with the other setting fails instead
+// of misreading its values. Decompression may run on the
+// threadpool; everything else happens on the JS thread.
+class MdbxCompression {
+ public:
+  typedef std::shared_ptr<const std::string> Dictionary;
+
+  static const char* const STORE_NAME;
+  static const size_t kDefaultThreshold = 256;
+
+  MdbxCompression(MDBX_dbi store, const std::string& owner, size_t threshold);
+
+  // Loads the current dictionary of `dbi`, if it has one. The first time an
+  // empty database is opened this way it is marked as compressed; one with
+  // values but no marker was created without compression and gives
+  // MDBX_INCOMPATIBLE.
+  int Open(MDBX_txn* txn, MDBX_dbi dbi);
+
+  // Whether `owner` is marked as compressed in `store`
+  static int IsMarked(MDBX_txn* txn, MDBX_dbi store, const std::string& owner, bool& marked);
+
+  // Removes the marker and dictionaries of a database being dropped
+  int Forget(MDBX_txn* txn);
+
+  // Writes the stored form of `value` to `out`
+  void Compress(const MDBX_val& value, std::string& out);
+
+  // Reads a stored value. `out` points into `in` for raw values and into
+  // `scratch` otherwise, which must outlive it.
+  int Decompress(MDBX_txn* txn, const MDBX_val& in, MDBX_val& out, std::string& scratch);
+
+  // Trains a dictionary of at most `maxSize` bytes from up to `samples`
+  // values of `dbi` and stores it as the current one in `txn`. `dictionary`
+  // is left empty if the values gave nothing to learn.
+  int Train(MDBX_txn* txn, MDBX_dbi dbi, size_t samples, size_t maxSize,
+            uint32_t& id, Dictionary& dictionary);
+
+  // Compresses with a dictionary stored by Train() once its transaction
+  // has committed
+  void SetCurrent(uint32_t id, const Dictionary& dictionary);
+
+ private:
+
+  static std::string StoreKey(const std::string& owner, char kind, uint32_t id);
+  std::string StoreKey(char kind, uint32_t id) const { return StoreKey(owner_, kind, id); }
+  int LoadDictionary(MDBX_txn* txn, uint32_t id, Dictionary& dictionary);
+
+  MDBX_dbi store_;
+  std::string owner_;
+  size_t threshold_;
+  uint32_t currentId_ = 0;
+  Dictionary current_;
+  std::mutex mutex_;
+  std::map<uint32_t, Dictionary> dictionaries_;
+};
+
+#endif // MDBX_COMPRESSION_H
\ No newline at end of file
@@ -0,0 +1,171 @@
+#include "core.h"
+
+namespace MdbxCore {
+
+int LoadValue(MdbxCompression* compression, MDBX_txn* txn, MDBX_val& data, std::string& scratch) {
+  if (!compression) {
+    return MDBX_SUCCESS;
+  }
+  MDBX_val stored = data;
+  return compression->Decompress(txn, stored, data, scratch);
+}
+
+void StoreValue(MdbxCompression* compression, MDBX_val& data, std::string& scratch) {
+  if (!compression) {
+    return;
+  }
+  compression->Compress(data, scratch);
+  data.iov_base = &scratch[0];
+  data.iov_len = scratch.size();
+}
+
+int Get(MDBX_txn* txn, MDBX_dbi dbi, MdbxCompression* compression,
+        const MDBX_val& key, MDBX_val& data, std::string& scratch) {
+  int rc = mdbx_get(txn, dbi, &key, &data);
+  if (rc == MDBX_SUCCESS) {
+    rc = LoadValue(compression, txn, data, scratch);
+  }
+  return rc;
+}
+
+int Put(MDBX_txn* txn, MDBX_dbi dbi, MdbxCompression* compression,
+        const MDBX_val& key, MDBX_val data, MDBX_put_flags_t flags, std::string& scratch) {
+  StoreValue(compression, data, scratch);
+  return mdbx_put(txn, dbi, &key, &data, flags);
+}
+
+bool InRange(MDBX_cursor* cursor, const Range& range, const MDBX_val& key) {
+  MDBX_txn* txn = mdbx_cursor_txn(cursor);
+  MDBX_dbi dbi = mdbx_cursor_dbi(cursor);
+  if (range.hasStart) {
+    int cmp = mdbx_cmp(txn, dbi, &key, &range.start);
+    if (cmp < 0 || (cmp == 0 && range.exclusiveStart)) {
+      return false;
+    }
+  }
+  if (range.hasEnd) {
+    int cmp = mdbx_cmp(txn, dbi, &key, &range.end);
+    if (cmp > 0 || (cmp == 0 && !range.inclusiveEnd)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool IsDupSort(MDBX_cursor* cursor) {
+  unsigned flags = 0;
+  mdbx_dbi_flags(mdbx_cursor_txn(cursor), mdbx_cursor_dbi(cursor), &flags);
+  return (flags & MDBX_DUPSORT) != 0;
+}
+
+int SeekRange(MDBX_cursor* cursor, const Range& range, MDBX_val& key, MDBX_val& data) {
+  MDBX_txn* txn = mdbx_cursor_txn(cursor);
+  MDBX_dbi dbi = mdbx_cursor_dbi(cursor);
+  int rc;
+
+  if (!range.reverse) {
+    if (range.hasStart) {
+      key = range.start;
+      rc = mdbx_cursor_get(cursor, &key, &data, MDBX_SET_RANGE);
+      if (rc == MDBX_SUCCESS && range.exclusiveStart &&
+          mdbx_cmp(txn, dbi, &key, &range.start) == 0) {
+        rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT_NODUP);
+      }
+    } else {
+      rc = mdbx_cursor_get(cursor, &key, &data, MDBX_FIRST);
+    }
+  } else if (range.hasEnd) {
+    key = range.end;
+    rc = mdbx_cursor_get(cursor, &key, &data, MDBX_SET_RANGE);
+    if (rc == MDBX_NOTFOUND) {
+      rc = mdbx_cursor_get(cursor, &key, &data, MDBX_LAST);
+    } else if (rc == MDBX_SUCCESS) {
+      int cmp = mdbx_cmp(txn, dbi, &key, &range.end);
+      if (cmp > 0 || (cmp == 0 && !range.inclusiveEnd)) {
+        rc = mdbx_cursor_get(cursor, &key, &data, MDBX_PREV);
+      } else if (IsDupSort(cursor)) {
+        // SET_RANGE lands on the first duplicate of the end key
+        rc = mdbx_cursor_get(cursor, &key, &data, MDBX_LAST_DUP);
+      }
+    }
+  } else {
+    rc = mdbx_cursor_get(cursor, &key, &data, MDBX_LAST);
+  }
+
+  if (rc == MDBX_SUCCESS && !InRange(cursor, range, key)) {
+    return MDBX_NOTFOUND;
+  }
+  return rc;
+}
+
+int NextInRange(MDBX_cursor* cursor, const Range& range, MDBX_val& key, MDBX_val& data) {
+  int rc = mdbx_cursor_get(cursor, &key, &data, range.reverse ? MDBX_PREV : MDBX_NEXT);
+  if (rc == MDBX_SUCCESS && !InRange(cursor, range, key)) {
+    return MDBX_NOTFOUND;
+  }
+  return rc;
+}
+
+int ScanRange(MDBX_cursor* cursor, const Range& range, std::vector<MDBX_val>* pairs, size_t& count) {
+  MDBX_val key, data;
+  count = 0;
+  int rc = range.limit > 0 ? SeekRange(cursor, range, key, data) : MDBX_NOTFOUND;
+
+  if (rc == MDBX_SUCCESS && !range.reverse && !IsDupSort(cursor)) {
+    // Forward scans of plain tables read a leaf page at a time
+    static const size_t kBatchItems = 512;
+    MDBX_val batch[kBatchItems];
+    MDBX_cursor_op op = MDBX_GET_CURRENT;
+    bool done = false;
+
+    while (!done) {
+      size_t remaining = range.limit - count;
+      size_t want = remaining < kBatchItems / 2 ? remaining * 2 : kBatchItems;
+      size_t items = 0;
+      rc = mdbx_cursor_get_batch(cursor, &items, batch, want, op);
+      if (rc == MDBX_NOTFOUND || rc == MDBX_ENODATA || (rc == MDBX_SUCCESS && items == 0)) {
+        rc = MDBX_NOTFOUND;
+        break;
+      } else if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+        break;
+      }
+
+      // MDBX_RESULT_TRUE means the page still has pairs past the ones returned
+      op = rc == MDBX_RESULT_TRUE ? MDBX_GET_CURRENT : MDBX_NEXT;
+      rc = MDBX_SUCCESS;
+
+      // Keys are sorted, so when the last one is in range the whole batch is
+      size_t inRange = items;
+      if (!InRange(cursor, range, batch[items - 2])) {
+        inRange = 0;
+        while (inRange < items && InRange(cursor, range, batch[inRange])) {
+          inRange += 2;
+        }
+        done = true;
+      }
+
+      if (pairs) {
+        pairs->insert(pairs->end(), batch, batch + inRange);
+      }
+      count += inRange / 2;
+      if (count >= range.limit) {
+        done = true;
+      }
+    }
+  } else {
+    while (rc == MDBX_SUCCESS) {
+      if (pairs) {
+        pairs->push_back(key);
+        pairs->push_back(data);
+      }
+      if (++count >= range.limit) {
+        break;
+      }
+      rc = NextInRange(cursor, range, key, data);
+    }
+  }
+
+  return rc == MDBX_NOTFOUND ? MDBX_SUCCESS : rc;
+}
+
+}  // namespace MdbxCore
\ No newline at end of file
@@ -0,0 +1,58 @@
+#ifndef MDBX_CORE_H
+#define MDBX_CORE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mdbx_wrapper.h"
+#include "compression.h"
+
+// The record-level work behind Transaction, Cursor and bound handles, kept
+// free of N-API so it can be driven directly by bench/native. The wrapper
+// classes only turn JS arguments into MDBX_vals and results back into JS.
+namespace MdbxCore {
+
+// Expands a value read from a database with `compression` (if any) in place,
+// using `scratch` for the expanded bytes
+int LoadValue(MdbxCompression* compression, MDBX_txn* txn, MDBX_val& data, std::string& scratch);
+
+// Compresses a value about to be written, pointing `data` at `scratch` when
+// `compression` is set
+void StoreValue(MdbxCompression* compression, MDBX_val& data, std::string& scratch);
+
+// mdbx_get followed by LoadValue
+int Get(MDBX_txn* txn, MDBX_dbi dbi, MdbxCompression* compression,
+        const MDBX_val& key, MDBX_val& data, std::string& scratch);
+
+// StoreValue followed by mdbx_put
+int Put(MDBX_txn* txn, MDBX_dbi dbi, MdbxCompression* compression,
+        const MDBX_val& key, MDBX_val data, MDBX_put_flags_t flags, std::string& scratch);
+
+// Key range walked by the native range operations. The bounds are in key
+// order whatever the direction; `start` is inclusive and `end` exclusive
+// unless overridden.
+struct Range {
+  MDBX_val start;
+  MDBX_val end;
+  bool hasStart = false;
+  bool hasEnd = false;
+  bool exclusiveStart = false;
+  bool inclusiveEnd = false;
+  bool reverse = false;
+  size_t limit = SIZE_MAX;
+};
+
+bool InRange(MDBX_cursor* cursor, const Range& range, const MDBX_val& key);
+bool IsDupSort(MDBX_cursor* cursor);
+// Positions the cursor on the first record of the range in its direction,
+// returning MDBX_NOTFOUND when the range is empty
+int SeekRange(MDBX_cursor* cursor, const Range& range, MDBX_val& key, MDBX_val& data);
+// Steps to the next record of the range, MDBX_NOTFOUND past its end
+int NextInRange(MDBX_cursor* cursor, const Range& range, MDBX_val& key, MDBX_val& data);
+// Walks the whole range, collecting alternating keys and values into
+// `pairs` unless it is null, and counting the records in `count`
+int ScanRange(MDBX_cursor* cursor, const Range& range, std::vector<MDBX_val>* pairs, size_t& count);
+
+}  // namespace MdbxCore
+
+#endif // MDBX_CORE_H
\ No newline at end of file
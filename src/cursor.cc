@@ -1,6 +1,13 @@
 #include "cursor.h"
+#include "core.h"
+#include "packed.h"
+#include "sharedkey.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
 
-Napi::FunctionReference MdbxCursor::constructor;
+thread_local Napi::FunctionReference MdbxCursor::constructor;
 
 Napi::Object MdbxCursor::Init(Napi::Env env, Napi::Object exports) {
   Napi::HandleScope scope(env);
@@ -10,7 +17,10 @@ Napi::Object MdbxCursor::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("del", &MdbxCursor::Del),
     InstanceMethod("get", &MdbxCursor::Get),
     InstanceMethod("put", &MdbxCursor::Put),
-    InstanceMethod("count", &MdbxCursor::Count)
+    InstanceMethod("count", &MdbxCursor::Count),
+    InstanceMethod("getRange", &MdbxCursor::GetRange),
+    InstanceMethod("countRange", &MdbxCursor::CountRange),
+    InstanceMethod("deleteRange", &MdbxCursor::DeleteRange)
   });
 
   constructor = Napi::Persistent(func);
@@ -85,6 +95,7 @@ void MdbxCursor::Del(const Napi::CallbackInfo& info) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
+  txn_->metrics_->Add(MdbxMetrics::DELS);
 }
 
 Napi::Value MdbxCursor::Get(const Napi::CallbackInfo& info) {
@@ -106,10 +117,8 @@ Napi::Value MdbxCursor::Get(const Napi::CallbackInfo& info) {
   MDBX_val key, data;
   
   // Initialize key if provided
-  if (info.Length() > 1 && info[1].IsBuffer()) {
-    Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
-    key.iov_base = keyBuffer.Data();
-    key.iov_len = keyBuffer.Length();
+  if (info.Length() > 1 && SharedKey::Resolve(info[1], key)) {
+    // key points at the Buffer, the shared key area or the string scratch
   } else {
     key.iov_base = nullptr;
     key.iov_len = 0;
@@ -125,7 +134,12 @@ Napi::Value MdbxCursor::Get(const Napi::CallbackInfo& info) {
     data.iov_len = 0;
   }
 
+  std::string scratch;
   int rc = mdbx_cursor_get(cursor_, &key, &data, op);
+  txn_->metrics_->Add(MdbxMetrics::CURSOR_STEPS);
+  if (rc == MDBX_SUCCESS) {
+    rc = dbi_->LoadValue(mdbx_cursor_txn(cursor_), data, scratch);
+  }
   if (rc == MDBX_NOTFOUND) {
     return env.Null();
   } else if (rc != MDBX_SUCCESS) {
@@ -135,13 +149,8 @@ Napi::Value MdbxCursor::Get(const Napi::CallbackInfo& info) {
 
   Napi::Object result = Napi::Object::New(env);
   
-  result.Set("key", Napi::Buffer<char>::Copy(env, 
-                                           static_cast<char*>(key.iov_base),
-                                           key.iov_len));
-  
-  result.Set("value", Napi::Buffer<char>::Copy(env, 
-                                             static_cast<char*>(data.iov_base),
-                                             data.iov_len));
+  result.Set("key", txn_->WrapValue(env, key));
+  result.Set("value", txn_->WrapValue(env, data));
 
   return result;
 }
@@ -155,30 +164,27 @@ void MdbxCursor::Put(const Napi::CallbackInfo& info) {
     return;
   }
 
-  if (info.Length() < 2 || !info[0].IsBuffer() || !info[1].IsBuffer()) {
-    Napi::TypeError::New(env, "Expected key buffer and value buffer").ThrowAsJavaScriptException();
+  MDBX_val key, data;
+  if (info.Length() < 2 || !SharedKey::Resolve(info[0], key) || !SharedKey::ResolveValue(info[1], data)) {
+    Napi::TypeError::New(env, "Expected key and value buffers or strings").ThrowAsJavaScriptException();
     return;
   }
 
-  Napi::Buffer<char> keyBuffer = info[0].As<Napi::Buffer<char>>();
-  Napi::Buffer<char> valueBuffer = info[1].As<Napi::Buffer<char>>();
-  
   unsigned int flags = 0;
   if (info.Length() > 2 && info[2].IsNumber()) {
     flags = info[2].ToNumber().Uint32Value();
   }
 
-  MDBX_val key, data;
-  key.iov_base = keyBuffer.Data();
-  key.iov_len = keyBuffer.Length();
-  data.iov_base = valueBuffer.Data();
-  data.iov_len = valueBuffer.Length();
+  size_t length = data.iov_len;
+  static thread_local std::string stored;
+  dbi_->StoreValue(data, stored);
 
   int rc = mdbx_cursor_put(cursor_, &key, &data, static_cast<MDBX_put_flags_t>(flags));
   if (rc != MDBX_SUCCESS) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
+  txn_->metrics_->Wrote(length);
 }
 
 Napi::Value MdbxCursor::Count(const Napi::CallbackInfo& info) {
@@ -197,5 +203,164 @@ Napi::Value MdbxCursor::Count(const Napi::CallbackInfo& info) {
     return env.Null();
   }
 
+  return Napi::Number::New(env, static_cast<double>(count));
+}
+
+bool MdbxCursor::ParseRange(Napi::Env env, const Napi::Value& options, Range& range) {
+  if (options.IsUndefined() || options.IsNull()) {
+    return true;
+  }
+  if (!options.IsObject()) {
+    Napi::TypeError::New(env, "Range options must be an object").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Object opts = options.As<Napi::Object>();
+  if (opts.Has("start") && opts.Get("start").IsBuffer()) {
+    Napi::Buffer<char> start = opts.Get("start").As<Napi::Buffer<char>>();
+    range.start.iov_base = start.Data();
+    range.start.iov_len = start.Length();
+    range.hasStart = true;
+  }
+  if (opts.Has("end") && opts.Get("end").IsBuffer()) {
+    Napi::Buffer<char> end = opts.Get("end").As<Napi::Buffer<char>>();
+    range.end.iov_base = end.Data();
+    range.end.iov_len = end.Length();
+    range.hasEnd = true;
+  }
+  if (opts.Has("exclusiveStart")) {
+    range.exclusiveStart = opts.Get("exclusiveStart").ToBoolean();
+  }
+  if (opts.Has("inclusiveEnd")) {
+    range.inclusiveEnd = opts.Get("inclusiveEnd").ToBoolean();
+  }
+  if (opts.Has("reverse")) {
+    range.reverse = opts.Get("reverse").ToBoolean();
+  }
+  if (opts.Has("limit") && opts.Get("limit").IsNumber()) {
+    // Infinity and anything past SIZE_MAX mean no limit; NaN means none at all
+    double limit = opts.Get("limit").ToNumber().DoubleValue();
+    if (!(limit > 0)) {
+      range.limit = 0;
+    } else if (!std::isfinite(limit) || limit >= static_cast<double>(SIZE_MAX)) {
+      range.limit = SIZE_MAX;
+    } else {
+      range.limit = static_cast<size_t>(limit);
+    }
+  }
+  return true;
+}
+
+Napi::Value MdbxCursor::GetRange(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!cursor_) {
+    Napi::Error::New(env, "Cursor is closed").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Range range;
+  if (!ParseRange(env, info.Length() > 0 ? info[0] : env.Undefined(), range)) {
+    return env.Null();
+  }
+
+  // Keys and values point into the map until the transaction ends, so they
+  // are only copied once, into the packed result
+  std::vector<MDBX_val> pairs;
+  size_t count = 0;
+  int rc = MdbxCore::ScanRange(cursor_, range, &pairs, count);
+  txn_->metrics_->Add(MdbxMetrics::CURSOR_STEPS, count);
+
+  // Compressed values are expanded into scratch strings of their own
+  std::vector<std::string> scratch(dbi_->compression_ ? pairs.size() / 2 : 0);
+  for (size_t i = 0; rc == MDBX_SUCCESS && i < scratch.size(); i++) {
+    rc = dbi_->LoadValue(mdbx_cursor_txn(cursor_), pairs[i * 2 + 1], scratch[i]);
+  }
+
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  size_t total = 0;
+  for (const MDBX_val& val : pairs) {
+    total += PackedSize(&val);
+  }
+  Napi::Buffer<char> result = Napi::Buffer<char>::New(env, total);
+  char* out = result.Data();
+  for (const MDBX_val& val : pairs) {
+    out = PackRecord(out, &val);
+  }
+  return result;
+}
+
+Napi::Value MdbxCursor::CountRange(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!cursor_) {
+    Napi::Error::New(env, "Cursor is closed").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Range range;
+  if (!ParseRange(env, info.Length() > 0 ? info[0] : env.Undefined(), range)) {
+    return env.Null();
+  }
+
+  size_t count = 0;
+  int rc = MdbxCore::ScanRange(cursor_, range, nullptr, count);
+  txn_->metrics_->Add(MdbxMetrics::CURSOR_STEPS, count);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return Napi::Number::New(env, static_cast<double>(count));
+}
+
+Napi::Value MdbxCursor::DeleteRange(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!cursor_) {
+    Napi::Error::New(env, "Cursor is closed").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (txn_->isReadOnly_) {
+    Napi::Error::New(env, "Cannot delete in a read-only transaction").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Range range;
+  if (!ParseRange(env, info.Length() > 0 ? info[0] : env.Undefined(), range)) {
+    return env.Null();
+  }
+
+  // After a delete the cursor already sits on the following record, which the
+  // next NEXT/PREV step returns instead of skipping
+  MDBX_val key, data;
+  size_t count = 0;
+  int rc = range.limit > 0 ? MdbxCore::SeekRange(cursor_, range, key, data) : MDBX_NOTFOUND;
+  while (rc == MDBX_SUCCESS) {
+    rc = mdbx_cursor_del(cursor_, static_cast<MDBX_put_flags_t>(0));
+    if (rc != MDBX_SUCCESS) {
+      break;
+    }
+    if (++count >= range.limit) {
+      break;
+    }
+    rc = MdbxCore::NextInRange(cursor_, range, key, data);
+  }
+
+  txn_->metrics_->Add(MdbxMetrics::CURSOR_STEPS, count);
+  txn_->metrics_->Add(MdbxMetrics::DELS, count);
+  if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
   return Napi::Number::New(env, static_cast<double>(count));
 }
\ No newline at end of file
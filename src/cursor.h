@@ -2,14 +2,17 @@
 #define MDBX_CURSOR_H
 
 #include <napi.h>
+#include <cstdint>
+#include <vector>
 #include "mdbx_wrapper.h"
 #include "txn.h"
 #include "dbi.h"
+#include "core.h"
 
 class MdbxCursor : public Napi::ObjectWrap<MdbxCursor> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
-  static Napi::FunctionReference constructor;
+  static thread_local Napi::FunctionReference constructor;
   
   MdbxCursor(const Napi::CallbackInfo& info);
   ~MdbxCursor();
@@ -25,6 +28,14 @@ class MdbxCursor : public Napi::ObjectWrap<MdbxCursor> {
   Napi::Value Get(const Napi::CallbackInfo& info);
   void Put(const Napi::CallbackInfo& info);
   Napi::Value Count(const Napi::CallbackInfo& info);
+  Napi::Value GetRange(const Napi::CallbackInfo& info);
+  Napi::Value CountRange(const Napi::CallbackInfo& info);
+  Napi::Value DeleteRange(const Napi::CallbackInfo& info);
+
+ private:
+  typedef MdbxCore::Range Range;
+
+  bool ParseRange(Napi::Env env, const Napi::Value& options, Range& range);
 };
 
 #endif // MDBX_CURSOR_H
\ No newline at end of file
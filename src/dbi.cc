@@ -1,6 +1,8 @@
 #include "dbi.h"
+#include "core.h"
+#include <algorithm>
 
-Napi::FunctionReference MdbxDbi::constructor;
+thread_local Napi::FunctionReference MdbxDbi::constructor;
 
 Napi::Object MdbxDbi::Init(Napi::Env env, Napi::Object exports) {
   Napi::HandleScope scope(env);
@@ -8,7 +10,10 @@ Napi::Object MdbxDbi::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "Database", {
     InstanceMethod("close", &MdbxDbi::Close),
     InstanceMethod("drop", &MdbxDbi::Drop),
-    InstanceMethod("stat", &MdbxDbi::Stat)
+    InstanceMethod("truncate", &MdbxDbi::Truncate),
+    InstanceMethod("stat", &MdbxDbi::Stat),
+    InstanceMethod("decode", &MdbxDbi::Decode),
+    InstanceMethod("trainDictionary", &MdbxDbi::TrainDictionary)
   });
 
   constructor = Napi::Persistent(func);
@@ -37,6 +42,9 @@ MdbxDbi::MdbxDbi(const Napi::CallbackInfo& info)
   // Parse options if provided
   std::string name;
   unsigned int flags = 0;
+  bool structures = false;
+  bool compression = false;
+  size_t threshold = MdbxCompression::kDefaultThreshold;
 
   if (info.Length() > 1 && info[1].IsObject()) {
     Napi::Object options = info[1].As<Napi::Object>();
@@ -55,6 +63,31 @@ MdbxDbi::MdbxDbi(const Napi::CallbackInfo& info)
     if (options.Has("create") && options.Get("create").ToBoolean() && !(flags & MDBX_CREATE)) {
       flags |= MDBX_CREATE;
     }
+
+    if (options.Has("structures")) {
+      structures = options.Get("structures").ToBoolean();
+    }
+
+    // `compression` is either a boolean or { threshold }
+    if (options.Has("compression")) {
+      Napi::Value value = options.Get("compression");
+      compression = value.ToBoolean();
+      if (value.IsObject() && value.As<Napi::Object>().Get("threshold").IsNumber()) {
+        int64_t min = value.As<Napi::Object>().Get("threshold").ToNumber().Int64Value();
+        threshold = min > 0 ? static_cast<size_t>(min) : 0;
+      }
+    }
+  }
+
+  if (compression && (flags & MDBX_DUPSORT)) {
+    Napi::Error::New(env, "Compression can't be used with DUPSORT databases").ThrowAsJavaScriptException();
+    return;
+  }
+
+  // The main database also holds the named ones, including the dictionaries
+  if (compression && name.empty()) {
+    Napi::Error::New(env, "Compression requires a named database").ThrowAsJavaScriptException();
+    return;
   }
 
   // Create a temporary transaction to open the database
@@ -68,37 +101,106 @@ MdbxDbi::MdbxDbi(const Napi::CallbackInfo& info)
   // Open the database
   const char* namePtr = name.empty() ? nullptr : name.c_str();
   rc = mdbx_dbi_open(txn, namePtr, static_cast<MDBX_db_flags_t>(flags), &dbi_);
+  if (rc == MDBX_SUCCESS && structures) {
+    rc = mdbx_dbi_open(txn, MdbxStructures::STORE_NAME, MDBX_CREATE, &structuresDbi_);
+  }
+  std::shared_ptr<MdbxStructures> recordStructures;
+  if (rc == MDBX_SUCCESS && structures) {
+    recordStructures = std::make_shared<MdbxStructures>(env_->env_, structuresDbi_, name);
+    rc = recordStructures->Open(txn);
+  }
+  std::shared_ptr<MdbxCompression> codec;
+  bool mismatch = false;
+  if (rc == MDBX_SUCCESS && compression) {
+    rc = mdbx_dbi_open(txn, MdbxCompression::STORE_NAME, MDBX_CREATE, &dictionariesDbi_);
+    if (rc == MDBX_SUCCESS) {
+      codec = std::make_shared<MdbxCompression>(dictionariesDbi_, name, threshold);
+      rc = codec->Open(txn, dbi_);
+      mismatch = rc == MDBX_INCOMPATIBLE;
+    }
+  } else if (rc == MDBX_SUCCESS) {
+    // Without compression, check the database wasn't created compressed. The
+    // store only exists once some database has used compression.
+    MDBX_dbi store;
+    rc = mdbx_dbi_open(txn, MdbxCompression::STORE_NAME, MDBX_DB_ACCEDE, &store);
+    bool marked = false;
+    if (rc == MDBX_SUCCESS) {
+      rc = MdbxCompression::IsMarked(txn, store, name, marked);
+    } else if (rc == MDBX_NOTFOUND) {
+      rc = MDBX_SUCCESS;
+    }
+    if (rc == MDBX_SUCCESS && marked) {
+      rc = MDBX_INCOMPATIBLE;
+      mismatch = true;
+    }
+  }
 
   // Commit or abort the transaction
   if (rc == MDBX_SUCCESS) {
-    rc = mdbx_txn_commit(txn);
-    isOpen_ = true;
+    rc = MdbxCommitStats::Commit(txn);
   } else {
     mdbx_txn_abort(txn);
   }
 
+  if (mismatch) {
+    std::string errorMsg = compression ? "Database " + name + " was created without compression" :
+                                         "Database " + name + " was created with compression";
+    Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+    return;
+  }
   if (rc != MDBX_SUCCESS) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
+
+  env_->shared_->RetainDbi(dbi_);
+  if (structures) {
+    env_->shared_->RetainDbi(structuresDbi_);
+    structures_ = recordStructures;
+  }
+  if (codec) {
+    env_->shared_->RetainDbi(dictionariesDbi_);
+    compression_ = codec;
+  }
+  isOpen_ = true;
+}
+
+void MdbxDbi::Release() {
+  env_->shared_->ReleaseDbi(dbi_);
+  if (structures_) {
+    env_->shared_->ReleaseDbi(structuresDbi_);
+    structures_.reset();
+  }
+  if (compression_) {
+    env_->shared_->ReleaseDbi(dictionariesDbi_);
+    compression_.reset();
+  }
+  isOpen_ = false;
 }
 
 MdbxDbi::~MdbxDbi() {
   if (isOpen_ && env_ && env_->isOpen_) {
-    // Note: mdbx_dbi_close is needed only if the environment will outlive
-    // this database instance, since mdbx_env_close closes all DBIs anyway
-    mdbx_dbi_close(env_->env_, dbi_);
-    isOpen_ = false;
+    // Note: closing the handle is needed only if the environment will outlive
+    // this database instance, since mdbx_env_close closes all DBIs anyway.
+    // Other Database objects, possibly in other threads, may share the handle.
+    Release();
   }
 }
 
+int MdbxDbi::LoadValue(MDBX_txn* txn, MDBX_val& data, std::string& scratch) {
+  return MdbxCore::LoadValue(compression_.get(), txn, data, scratch);
+}
+
+void MdbxDbi::StoreValue(MDBX_val& data, std::string& scratch) {
+  MdbxCore::StoreValue(compression_.get(), data, scratch);
+}
+
 void MdbxDbi::Close(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
   if (isOpen_ && env_ && env_->isOpen_) {
-    mdbx_dbi_close(env_->env_, dbi_);
-    isOpen_ = false;
+    Release();
   }
 }
 
@@ -124,12 +226,16 @@ void MdbxDbi::Drop(const Napi::CallbackInfo& info) {
     return;
   }
 
-  // Drop the database
+  // Drop the database, along with its compression marker and dictionaries so
+  // a database created later under the same name starts afresh
   rc = mdbx_drop(txn, dbi_, true);
+  if (rc == MDBX_SUCCESS && compression_) {
+    rc = compression_->Forget(txn);
+  }
   
   // Commit or abort the transaction
   if (rc == MDBX_SUCCESS) {
-    rc = mdbx_txn_commit(txn);
+    rc = MdbxCommitStats::Commit(txn);
   } else {
     mdbx_txn_abort(txn);
   }
@@ -139,9 +245,52 @@ void MdbxDbi::Drop(const Napi::CallbackInfo& info) {
     return;
   }
 
+  env_->shared_->ForgetDbi(dbi_);
+  if (structures_) {
+    env_->shared_->ReleaseDbi(structuresDbi_);
+    structures_.reset();
+  }
+  if (compression_) {
+    env_->shared_->ReleaseDbi(dictionariesDbi_);
+    compression_.reset();
+  }
   isOpen_ = false;
 }
 
+void MdbxDbi::Truncate(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Expected transaction object").ThrowAsJavaScriptException();
+    return;
+  }
+
+  MdbxTxn* txn = Napi::ObjectWrap<MdbxTxn>::Unwrap(info[0].As<Napi::Object>());
+  if (!txn || !txn->txn_) {
+    Napi::Error::New(env, "Transaction is not active").ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (txn->isReadOnly_) {
+    Napi::Error::New(env, "Cannot write to a read-only transaction").ThrowAsJavaScriptException();
+    return;
+  }
+
+  // Frees the table's pages wholesale instead of deleting record by record,
+  // keeping the handle open
+  int rc = mdbx_drop(txn->txn_, dbi_, false);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
 Napi::Value MdbxDbi::Stat(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -178,4 +327,101 @@ Napi::Value MdbxDbi::Stat(const Napi::CallbackInfo& info) {
   result.Set("page_size", Napi::Number::New(env, stat.ms_psize));
 
   return result;
+}
+
+Napi::Value MdbxDbi::Decode(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected value buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<unsigned char> buffer = info[0].As<Napi::Buffer<unsigned char>>();
+  if (!structures_) {
+    Napi::Value value = Msgpack::Decode(env, buffer.Data(), buffer.Length());
+    return value.IsEmpty() ? env.Null() : value;
+  }
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Structures unknown to the cache are read through the given transaction,
+  // or a short read-only one without it
+  MDBX_txn* txn = nullptr;
+  if (info.Length() > 1 && info[1].IsObject()) {
+    MdbxTxn* mdbxTxn = Napi::ObjectWrap<MdbxTxn>::Unwrap(info[1].As<Napi::Object>());
+    if (!mdbxTxn || !mdbxTxn->txn_) {
+      Napi::Error::New(env, "Transaction is not active").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    txn = mdbxTxn->txn_;
+  }
+
+  MdbxStructures::Session session(*structures_, txn, false);
+  Napi::Value value = Msgpack::Decode(env, buffer.Data(), buffer.Length(), &session);
+  return value.IsEmpty() ? env.Null() : value;
+}
+
+Napi::Value MdbxDbi::TrainDictionary(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!compression_) {
+    Napi::Error::New(env, "Database was not opened with compression").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  size_t samples = 1000;
+  size_t maxSize = 32 * 1024;
+  if (info.Length() > 0 && info[0].IsObject()) {
+    Napi::Object options = info[0].As<Napi::Object>();
+    if (options.Get("samples").IsNumber()) {
+      int64_t value = options.Get("samples").ToNumber().Int64Value();
+      samples = value > 0 ? static_cast<size_t>(value) : 0;
+    }
+    if (options.Get("maxSize").IsNumber()) {
+      int64_t value = options.Get("maxSize").ToNumber().Int64Value();
+      // Matches can only reach 64KiB back
+      maxSize = value > 0 ? static_cast<size_t>(std::min<int64_t>(value, 65535)) : 0;
+    }
+  }
+
+  // Create a transaction to sample the values and store the dictionary
+  MDBX_txn* txn;
+  int rc = mdbx_txn_begin(env_->env_, nullptr, static_cast<MDBX_txn_flags_t>(0), &txn);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  uint32_t id = 0;
+  MdbxCompression::Dictionary dictionary;
+  rc = compression_->Train(txn, dbi_, samples, maxSize, id, dictionary);
+
+  // Commit or abort the transaction
+  if (rc == MDBX_SUCCESS) {
+    rc = MdbxCommitStats::Commit(txn);
+  } else {
+    mdbx_txn_abort(txn);
+  }
+
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Values written from now on are compressed against the new dictionary
+  if (dictionary) {
+    compression_->SetCurrent(id, dictionary);
+  }
+  return Napi::Number::New(env, dictionary ? static_cast<double>(dictionary->size()) : 0);
 }
\ No newline at end of file
@@ -2,15 +2,18 @@
 #define MDBX_DBI_H
 
 #include <napi.h>
+#include <memory>
 #include <string>
 #include "mdbx_wrapper.h"
 #include "env.h"
 #include "txn.h"
+#include "structures.h"
+#include "compression.h"
 
 class MdbxDbi : public Napi::ObjectWrap<MdbxDbi> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
-  static Napi::FunctionReference constructor;
+  static thread_local Napi::FunctionReference constructor;
   
   MdbxDbi(const Napi::CallbackInfo& info);
   ~MdbxDbi();
@@ -19,14 +22,34 @@ class MdbxDbi : public Napi::ObjectWrap<MdbxDbi> {
   MDBX_dbi dbi_;
   MdbxEnv* env_;
   bool isOpen_;
+  // Record structures of a MessagePack database opened with `structures`,
+  // kept in their own table of the environment
+  std::shared_ptr<MdbxStructures> structures_;
+  MDBX_dbi structuresDbi_ = 0;
+  // Value compression of a database opened with `compression`. Shared with
+  // async reads, which decompress on the threadpool.
+  std::shared_ptr<MdbxCompression> compression_;
+  MDBX_dbi dictionariesDbi_ = 0;
+  
+  // Convert between stored values and the values callers see, which differ
+  // only for compressed databases. `scratch` backs the result when needed and
+  // must not hold the input.
+  int LoadValue(MDBX_txn* txn, MDBX_val& data, std::string& scratch);
+  void StoreValue(MDBX_val& data, std::string& scratch);
   
   // Node.js methods
   void Close(const Napi::CallbackInfo& info);
   void Drop(const Napi::CallbackInfo& info);
+  void Truncate(const Napi::CallbackInfo& info);
   Napi::Value Stat(const Napi::CallbackInfo& info);
+  Napi::Value Decode(const Napi::CallbackInfo& info);
+  Napi::Value TrainDictionary(const Napi::CallbackInfo& info);
 
   friend class MdbxTxn;
   friend class MdbxCursor;
+
+ private:
+  void Release();
 };
 
 #endif // MDBX_DBI_H
\ No newline at end of file
@@ -1,8 +1,16 @@
 #include "env.h"
+#include "dbi.h"
+#include "workers.h"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <thread>
+#include <vector>
 
-Napi::FunctionReference MdbxEnv::constructor;
+thread_local Napi::FunctionReference MdbxEnv::constructor;
 
 Napi::Object MdbxEnv::Init(Napi::Env env, Napi::Object exports) {
   Napi::HandleScope scope(env);
@@ -13,8 +21,18 @@ Napi::Object MdbxEnv::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("sync", &MdbxEnv::Sync),
     InstanceMethod("stat", &MdbxEnv::Stat),
     InstanceMethod("info", &MdbxEnv::Info),
+    InstanceMethod("commitStats", &MdbxEnv::CommitStats),
+    InstanceMethod("metrics", &MdbxEnv::Metrics),
+    InstanceMethod("readers", &MdbxEnv::Readers),
+    InstanceMethod("checkReaders", &MdbxEnv::CheckReaders),
     InstanceMethod("copy", &MdbxEnv::Copy),
     InstanceMethod("setMapSize", &MdbxEnv::SetMapSize),
+    InstanceMethod("getAsync", &MdbxEnv::GetAsync),
+    InstanceMethod("putAsync", &MdbxEnv::PutAsync),
+    InstanceMethod("delAsync", &MdbxEnv::DelAsync),
+    InstanceMethod("writerPut", &MdbxEnv::WriterPut),
+    InstanceMethod("writerDel", &MdbxEnv::WriterDel),
+    InstanceMethod("writerFlush", &MdbxEnv::WriterFlush),
   });
 
   constructor = Napi::Persistent(func);
@@ -26,23 +44,134 @@ Napi::Object MdbxEnv::Init(Napi::Env env, Napi::Object exports) {
 
 MdbxEnv::MdbxEnv(const Napi::CallbackInfo& info) 
   : Napi::ObjectWrap<MdbxEnv>(info) {
-  Napi::Env env = info.Env();
-  Napi::HandleScope scope(env);
+}
 
-  int rc = mdbx_env_create(&env_);
-  if (rc != MDBX_SUCCESS) {
-    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+MdbxEnv::~MdbxEnv() {
+  writer_.reset();
+  if (isOpen_) {
+    Detach();
+  }
+}
+
+void MdbxSharedEnv::RetainDbi(MDBX_dbi dbi) {
+  std::lock_guard<std::mutex> lock(dbiMutex);
+  ++dbiRefs[dbi];
+}
+
+void MdbxSharedEnv::ReleaseDbi(MDBX_dbi dbi) {
+  std::lock_guard<std::mutex> lock(dbiMutex);
+  auto it = dbiRefs.find(dbi);
+  if (it == dbiRefs.end()) {
     return;
   }
+  if (--it->second == 0) {
+    dbiRefs.erase(it);
+    mdbx_dbi_close(env, dbi);
+  }
 }
 
-MdbxEnv::~MdbxEnv() {
-  if (isOpen_) {
-    mdbx_env_close(env_);
-    isOpen_ = false;
+void MdbxSharedEnv::ForgetDbi(MDBX_dbi dbi) {
+  std::lock_guard<std::mutex> lock(dbiMutex);
+  dbiRefs.erase(dbi);
+}
+
+// Shared environments keyed by canonical path
+static std::mutex registryMutex;
+static std::map<std::string, MdbxSharedEnv*> registry;
+
+MDBX_txn* MdbxEnv::AcquireReadTxn() {
+  while (!readTxnPool_.empty()) {
+    MDBX_txn* txn = readTxnPool_.back();
+    readTxnPool_.pop_back();
+
+    if (mdbx_txn_renew(txn) == MDBX_SUCCESS) {
+      return txn;
+    }
+    mdbx_txn_abort(txn);
   }
+  return nullptr;
 }
 
+bool MdbxEnv::ReleaseReadTxn(MDBX_txn* txn, bool isReset) {
+  if (!isOpen_ || readTxnPool_.size() >= readTxnPoolSize_) {
+    return false;
+  }
+
+  // Resetting releases the snapshot but keeps the reader slot
+  if (!isReset && mdbx_txn_reset(txn) != MDBX_SUCCESS) {
+    return false;
+  }
+
+  readTxnPool_.push_back(txn);
+  return true;
+}
+
+void MdbxEnv::Detach() {
+  for (MDBX_txn* txn : readTxnPool_) {
+    mdbx_txn_abort(txn);
+  }
+  readTxnPool_.clear();
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  isOpen_ = false;
+  auto threadRefs = shared_->threadRefs.find(std::this_thread::get_id());
+  bool lastOnThread = threadRefs == shared_->threadRefs.end() || --threadRefs->second == 0;
+  if (lastOnThread && threadRefs != shared_->threadRefs.end()) {
+    shared_->threadRefs.erase(threadRefs);
+  }
+
+  if (--shared_->refs == 0) {
+    registry.erase(shared_->path);
+    mdbx_env_close(shared_->env);
+    delete shared_;
+  } else if (lastOnThread && !(shared_->flags & MDBX_NOTLS)) {
+    // Give this thread's reader slot back once no Environment on it is left;
+    // fails harmlessly while the thread still has a read transaction running
+    mdbx_thread_unregister(env_);
+  }
+
+  shared_ = nullptr;
+  env_ = nullptr;
+}
+
+namespace {
+
+// How often a waiting write transaction rescans the reader table
+const unsigned kSlowReaderPollMs = 10;
+
+// Handle-Slow-Readers callback, called by a write transaction that needs pages
+// an old read snapshot still pins, once per retry. Returning 0 rescans the
+// reader table and -1 gives up so libmdbx grows the map or fails with
+// MDBX_MAP_FULL. A negative `retry` only reports the end of a handling loop.
+// The wait sleeps on the thread committing, holding the write lock: the JS
+// thread for synchronous writes.
+int HandleSlowReader(const MDBX_env* env, const MDBX_txn*, mdbx_pid_t pid, mdbx_tid_t,
+                     uint64_t laggard, unsigned gap, size_t space, int retry) MDBX_CXX17_NOEXCEPT {
+  MdbxSharedEnv* shared = static_cast<MdbxSharedEnv*>(mdbx_env_get_userctx(env));
+  if (!shared || retry < 0) {
+    return shared ? 0 : -1;
+  }
+
+  if (retry == 0) {
+    shared->metrics.Add(MdbxMetrics::SLOW_READERS);
+    if (shared->slowReaderPolicy == MdbxSharedEnv::SLOW_READERS_LOG) {
+      std::fprintf(stderr, "mdbxjs: reader of process %ld at txn %" PRIu64 " is %u commits behind,"
+                   " keeping %zu bytes from reuse in %s\n",
+                   static_cast<long>(pid), laggard, gap, space, shared->path.c_str());
+    }
+  }
+
+  if (shared->slowReaderPolicy == MdbxSharedEnv::SLOW_READERS_WAIT &&
+      static_cast<unsigned>(retry) * kSlowReaderPollMs < shared->slowReaderWaitMs) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(kSlowReaderPollMs));
+    return 0;
+  }
+  return -1;
+}
+
+}  // namespace
+
 Napi::Value MdbxEnv::Open(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -68,24 +197,32 @@ Napi::Value MdbxEnv::Open(const Napi::CallbackInfo& info) {
   int flags = options.Has("flags") ? 
     options.Get("flags").ToNumber().Int32Value() : 0;
 
-  // Set map size
-  int rc = mdbx_env_set_mapsize(env_, mapSize);
-  if (rc != MDBX_SUCCESS) {
-    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
-    return env.Null();
+  if (options.Has("readTxnPoolSize") && options.Get("readTxnPoolSize").IsNumber()) {
+    readTxnPoolSize_ = options.Get("readTxnPoolSize").ToNumber().Uint32Value();
   }
 
-  // Set max databases
-  rc = mdbx_env_set_maxdbs(env_, maxDbs);
-  if (rc != MDBX_SUCCESS) {
-    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
-    return env.Null();
+  MdbxSharedEnv::SlowReaderPolicy slowReaderPolicy = MdbxSharedEnv::SLOW_READERS_FAIL;
+  unsigned slowReaderWaitMs = 0;
+  if (options.Has("slowReaders") && options.Get("slowReaders").IsObject()) {
+    Napi::Object slowReaders = options.Get("slowReaders").As<Napi::Object>();
+    std::string policy = slowReaders.Has("policy") ?
+      std::string(slowReaders.Get("policy").ToString()) : "log";
+    if (policy == "log") {
+      slowReaderPolicy = MdbxSharedEnv::SLOW_READERS_LOG;
+    } else if (policy == "wait") {
+      slowReaderPolicy = MdbxSharedEnv::SLOW_READERS_WAIT;
+      slowReaderWaitMs = 1000;
+    } else {
+      Napi::TypeError::New(env, "slowReaders.policy must be 'log' or 'wait'").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    if (slowReaders.Has("waitMs") && slowReaders.Get("waitMs").IsNumber()) {
+      slowReaderWaitMs = slowReaders.Get("waitMs").ToNumber().Uint32Value();
+    }
   }
 
-  // Set max readers
-  rc = mdbx_env_set_maxreaders(env_, maxReaders);
-  if (rc != MDBX_SUCCESS) {
-    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+  if (isOpen_) {
+    Napi::Error::New(env, "Environment is already open").ThrowAsJavaScriptException();
     return env.Null();
   }
 
@@ -98,12 +235,86 @@ Napi::Value MdbxEnv::Open(const Napi::CallbackInfo& info) {
     return env.Null();
   }
 
-  // Open environment
-  rc = mdbx_env_open(env_, path.c_str(), static_cast<MDBX_env_flags_t>(flags), 0664);
-  if (rc != MDBX_SUCCESS) {
-    std::string errorMsg = "Failed to open environment at " + path + ": " + mdbx_strerror(rc);
-    Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
-    return env.Null();
+  std::string key = std::filesystem::weakly_canonical(path, ec).string();
+  if (ec) {
+    key = path;
+  }
+
+  std::lock_guard<std::mutex> lock(registryMutex);
+
+  auto it = registry.find(key);
+  if (it != registry.end()) {
+    // Attach to the environment another Environment object already opened;
+    // its geometry and limits were set by the first opener
+    MdbxSharedEnv* shared = it->second;
+    if (shared->flags != static_cast<unsigned int>(flags)) {
+      std::string errorMsg = "Environment at " + path + " is already open with different flags";
+      Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    shared->refs++;
+    shared_ = shared;
+    env_ = shared->env;
+  } else {
+    MDBX_env* mdbxEnv;
+    int rc = mdbx_env_create(&mdbxEnv);
+    if (rc != MDBX_SUCCESS) {
+      Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    // Set map size
+    rc = mdbx_env_set_mapsize(mdbxEnv, mapSize);
+
+    // Set max databases
+    if (rc == MDBX_SUCCESS) {
+      rc = mdbx_env_set_maxdbs(mdbxEnv, maxDbs);
+    }
+
+    // Set max readers
+    if (rc == MDBX_SUCCESS) {
+      rc = mdbx_env_set_maxreaders(mdbxEnv, maxReaders);
+    }
+
+    // The callback finds its policy through the env's userctx, set below
+    if (rc == MDBX_SUCCESS && slowReaderPolicy != MdbxSharedEnv::SLOW_READERS_FAIL) {
+      rc = mdbx_env_set_hsr(mdbxEnv, HandleSlowReader);
+    }
+
+    if (rc != MDBX_SUCCESS) {
+      mdbx_env_close(mdbxEnv);
+      Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    // Open environment
+    rc = mdbx_env_open(mdbxEnv, path.c_str(), static_cast<MDBX_env_flags_t>(flags), 0664);
+    if (rc != MDBX_SUCCESS) {
+      mdbx_env_close(mdbxEnv);
+      std::string errorMsg = "Failed to open environment at " + path + ": " + mdbx_strerror(rc);
+      Napi::Error::New(env, errorMsg).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    shared_ = new MdbxSharedEnv();
+    shared_->env = mdbxEnv;
+    shared_->path = key;
+    shared_->flags = static_cast<unsigned int>(flags);
+    shared_->refs = 1;
+    shared_->slowReaderPolicy = slowReaderPolicy;
+    shared_->slowReaderWaitMs = slowReaderWaitMs;
+    mdbx_env_set_userctx(mdbxEnv, shared_);
+    registry[key] = shared_;
+    env_ = mdbxEnv;
+  }
+
+  shared_->threadRefs[std::this_thread::get_id()]++;
+
+  // Claim a reader slot for this thread up front rather than on its first
+  // read transaction
+  if (!(shared_->flags & MDBX_NOTLS)) {
+    mdbx_thread_register(env_);
   }
 
   isOpen_ = true;
@@ -114,9 +325,16 @@ void MdbxEnv::Close(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
+  if (pendingAsync_ > 0) {
+    Napi::Error::New(env, "Environment has pending async operations").ThrowAsJavaScriptException();
+    return;
+  }
+
+  // Commit anything still queued while the environment is open
+  writer_.reset();
+
   if (isOpen_) {
-    mdbx_env_close(env_);
-    isOpen_ = false;
+    Detach();
   }
 }
 
@@ -196,6 +414,164 @@ Napi::Value MdbxEnv::Info(const Napi::CallbackInfo& info) {
   return result;
 }
 
+// Returns the commit latency histograms per phase, in microseconds, and
+// clears them when passed true
+Napi::Value MdbxEnv::CommitStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  for (int phase = 0; phase < MdbxCommitStats::PHASES; phase++) {
+    MdbxCommitStats::Histogram histogram = shared_->commitStats.Read(static_cast<MdbxCommitStats::Phase>(phase));
+
+    Napi::Array buckets = Napi::Array::New(env, MdbxCommitStats::kBuckets);
+    for (int i = 0; i < MdbxCommitStats::kBuckets; i++) {
+      buckets.Set(i, Napi::Number::New(env, static_cast<double>(histogram.buckets[i])));
+    }
+
+    Napi::Object stats = Napi::Object::New(env);
+    stats.Set("count", Napi::Number::New(env, static_cast<double>(histogram.count)));
+    stats.Set("totalUs", Napi::Number::New(env, static_cast<double>(histogram.totalUs)));
+    stats.Set("maxUs", Napi::Number::New(env, static_cast<double>(histogram.maxUs)));
+    stats.Set("buckets", buckets);
+    result.Set(MdbxCommitStats::kPhaseNames[phase], stats);
+  }
+
+  if (info.Length() > 0 && info[0].ToBoolean()) {
+    shared_->commitStats.Reset();
+  }
+  return result;
+}
+
+// Returns the operation counters and latency summaries, in nanoseconds, and
+// clears them when passed true
+Napi::Value MdbxEnv::Metrics(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxMetrics& metrics = shared_->metrics;
+  Napi::Object result = Napi::Object::New(env);
+  for (int counter = 0; counter < MdbxMetrics::COUNTERS; counter++) {
+    uint64_t value = metrics.Read(static_cast<MdbxMetrics::Counter>(counter));
+    result.Set(MdbxMetrics::kCounterNames[counter], Napi::Number::New(env, static_cast<double>(value)));
+  }
+
+  Napi::Object latency = Napi::Object::New(env);
+  for (int histogram = 0; histogram < MdbxMetrics::HISTOGRAMS; histogram++) {
+    MdbxMetrics::Summary summary = metrics.Summarize(static_cast<MdbxMetrics::Histogram>(histogram));
+    Napi::Object stats = Napi::Object::New(env);
+    stats.Set("count", Napi::Number::New(env, static_cast<double>(summary.count)));
+    stats.Set("meanNs", Napi::Number::New(env, summary.meanNs));
+    stats.Set("maxNs", Napi::Number::New(env, static_cast<double>(summary.maxNs)));
+    stats.Set("p50Ns", Napi::Number::New(env, summary.p50Ns));
+    stats.Set("p90Ns", Napi::Number::New(env, summary.p90Ns));
+    stats.Set("p99Ns", Napi::Number::New(env, summary.p99Ns));
+    stats.Set("p999Ns", Napi::Number::New(env, summary.p999Ns));
+    latency.Set(MdbxMetrics::kHistogramNames[histogram], stats);
+  }
+  result.Set("latency", latency);
+
+  if (info.Length() > 0 && info[0].ToBoolean()) {
+    metrics.Reset();
+  }
+  return result;
+}
+
+namespace {
+
+struct ReaderSlot {
+  int slot;
+  double pid;
+  double thread;
+  uint64_t txnid;
+  uint64_t lag;
+  size_t bytesUsed;
+  size_t bytesRetained;
+};
+
+// mdbx_tid_t is an integer on some platforms and an opaque pointer on others
+template <typename T>
+double ThreadNumber(T thread) {
+  uint64_t number = 0;
+  std::memcpy(&number, &thread, sizeof(thread) < sizeof(number) ? sizeof(thread) : sizeof(number));
+  return static_cast<double>(number);
+}
+
+int CollectReader(void* ctx, int num, int slot, mdbx_pid_t pid, mdbx_tid_t thread,
+                  uint64_t txnid, uint64_t lag, size_t bytesUsed, size_t bytesRetained) MDBX_CXX17_NOEXCEPT {
+  static_cast<std::vector<ReaderSlot>*>(ctx)->push_back(
+    { slot, static_cast<double>(pid), ThreadNumber(thread), txnid, lag, bytesUsed, bytesRetained });
+  return 0;
+}
+
+}  // namespace
+
+// Lists the occupied slots of the reader table, including those of other
+// processes. `lag` is how many transactions were committed since the reader's
+// snapshot, and `bytesRetained` how much space it keeps from being reused.
+Napi::Value MdbxEnv::Readers(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::vector<ReaderSlot> readers;
+  int rc = mdbx_reader_list(env_, CollectReader, &readers);
+  if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Array result = Napi::Array::New(env, readers.size());
+  for (size_t i = 0; i < readers.size(); i++) {
+    const ReaderSlot& reader = readers[i];
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("slot", Napi::Number::New(env, reader.slot));
+    entry.Set("pid", Napi::Number::New(env, reader.pid));
+    entry.Set("thread", Napi::Number::New(env, reader.thread));
+    entry.Set("txnid", Napi::Number::New(env, static_cast<double>(reader.txnid)));
+    entry.Set("lag", Napi::Number::New(env, static_cast<double>(reader.lag)));
+    entry.Set("bytesUsed", Napi::Number::New(env, static_cast<double>(reader.bytesUsed)));
+    entry.Set("bytesRetained", Napi::Number::New(env, static_cast<double>(reader.bytesRetained)));
+    result.Set(static_cast<uint32_t>(i), entry);
+  }
+  return result;
+}
+
+// Clears reader slots left behind by processes that exited without releasing
+// them, returning how many were cleared
+Napi::Value MdbxEnv::CheckReaders(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  int dead = 0;
+  int rc = mdbx_reader_check(env_, &dead);
+  if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return Napi::Number::New(env, dead);
+}
+
 void MdbxEnv::Copy(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -249,4 +625,221 @@ void MdbxEnv::SetMapSize(const Napi::CallbackInfo& info) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
+}
+
+Napi::Value MdbxEnv::GetAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object dbiObj = info[0].As<Napi::Object>();
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(dbiObj);
+  if (!dbi || !dbi->isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+
+  MdbxGetWorker* worker = new MdbxGetWorker(env, &pendingAsync_, {info.This().As<Napi::Object>(), dbiObj},
+                                            env_, nullptr, nullptr, dbi->dbi_, dbi->compression_,
+                                            keyBuffer.Data(), keyBuffer.Length());
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value MdbxEnv::PutAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 3 || !info[0].IsObject() || !info[1].IsBuffer() || !info[2].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected database, key buffer, and value buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object dbiObj = info[0].As<Napi::Object>();
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(dbiObj);
+  if (!dbi || !dbi->isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+  Napi::Buffer<char> valueBuffer = info[2].As<Napi::Buffer<char>>();
+
+  unsigned int flags = 0;
+  if (info.Length() > 3 && info[3].IsNumber()) {
+    flags = info[3].ToNumber().Uint32Value();
+  }
+
+  // Values are compressed here, the worker only copies the result
+  MDBX_val data;
+  data.iov_base = valueBuffer.Data();
+  data.iov_len = valueBuffer.Length();
+  std::string stored;
+  dbi->StoreValue(data, stored);
+
+  MdbxWriteWorker* worker = new MdbxWriteWorker(env, &pendingAsync_, {info.This().As<Napi::Object>(), dbiObj},
+                                                env_, dbi->dbi_, false,
+                                                keyBuffer.Data(), keyBuffer.Length(),
+                                                static_cast<const char*>(data.iov_base), data.iov_len, true,
+                                                flags);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value MdbxEnv::DelAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object dbiObj = info[0].As<Napi::Object>();
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(dbiObj);
+  if (!dbi || !dbi->isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+
+  // Check if value is provided (for DUPSORT databases)
+  bool hasValue = info.Length() > 2 && info[2].IsBuffer();
+  Napi::Buffer<char> valueBuffer;
+  if (hasValue) {
+    valueBuffer = info[2].As<Napi::Buffer<char>>();
+  }
+
+  MdbxWriteWorker* worker = new MdbxWriteWorker(env, &pendingAsync_, {info.This().As<Napi::Object>(), dbiObj},
+                                                env_, dbi->dbi_, true,
+                                                keyBuffer.Data(), keyBuffer.Length(),
+                                                hasValue ? valueBuffer.Data() : nullptr,
+                                                hasValue ? valueBuffer.Length() : 0, hasValue,
+                                                0);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
+}
+
+Napi::Value MdbxEnv::WriterPut(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 3 || !info[0].IsObject() || !info[1].IsBuffer() || !info[2].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected database, key buffer, and value buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi || !dbi->isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+  Napi::Buffer<char> valueBuffer = info[2].As<Napi::Buffer<char>>();
+
+  unsigned int flags = 0;
+  if (info.Length() > 3 && info[3].IsNumber()) {
+    flags = info[3].ToNumber().Uint32Value();
+  }
+
+  if (!writer_) {
+    writer_.reset(new MdbxWriter(env, env_));
+  }
+
+  MDBX_val data;
+  data.iov_base = valueBuffer.Data();
+  data.iov_len = valueBuffer.Length();
+  std::string stored;
+  dbi->StoreValue(data, stored);
+
+  return writer_->Put(env, dbi->dbi_,
+                      keyBuffer.Data(), keyBuffer.Length(),
+                      static_cast<const char*>(data.iov_base), data.iov_len,
+                      flags);
+}
+
+Napi::Value MdbxEnv::WriterDel(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi || !dbi->isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+
+  // Check if value is provided (for DUPSORT databases)
+  bool hasValue = info.Length() > 2 && info[2].IsBuffer();
+  Napi::Buffer<char> valueBuffer;
+  if (hasValue) {
+    valueBuffer = info[2].As<Napi::Buffer<char>>();
+  }
+
+  if (!writer_) {
+    writer_.reset(new MdbxWriter(env, env_));
+  }
+
+  return writer_->Del(env, dbi->dbi_,
+                      keyBuffer.Data(), keyBuffer.Length(),
+                      hasValue ? valueBuffer.Data() : nullptr,
+                      hasValue ? valueBuffer.Length() : 0, hasValue);
+}
+
+Napi::Value MdbxEnv::WriterFlush(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!isOpen_) {
+    Napi::Error::New(env, "Environment is not open").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!writer_) {
+    writer_.reset(new MdbxWriter(env, env_));
+  }
+
+  return writer_->Flush(env);
 }
\ No newline at end of file
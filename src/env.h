@@ -2,20 +2,79 @@
 #define MDBX_ENV_H
 
 #include <napi.h>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include "mdbx_wrapper.h"
+#include "writer.h"
+#include "commitstats.h"
+#include "metrics.h"
+
+// Process-wide state for one native MDBX_env. Every Environment opened on the
+// same path attaches to it, including ones in other worker_threads, so they
+// share a single memory map, lock file and reader table.
+struct MdbxSharedEnv {
+  MDBX_env* env;
+  std::string path;
+  unsigned int flags;
+  // Attached Environment objects
+  int refs;
+  // Attached Environment objects per JS thread; a thread's reader slot is
+  // only given back when the last of them detaches. Guarded by the registry
+  // mutex, like refs.
+  std::map<std::thread::id, int> threadRefs;
+
+  // DBI handles are per MDBX_env, so one is only closed when the last
+  // Database object using it goes away
+  std::mutex dbiMutex;
+  std::map<MDBX_dbi, int> dbiRefs;
+
+  void RetainDbi(MDBX_dbi dbi);
+  void ReleaseDbi(MDBX_dbi dbi);
+  // mdbx_drop(..., true) has already closed the handle
+  void ForgetDbi(MDBX_dbi dbi);
+
+  // Latency of every write transaction committed through the binding
+  MdbxCommitStats commitStats;
+  // Operation counters and latencies, see env.metrics()
+  MdbxMetrics metrics;
+
+  // What the Handle-Slow-Readers callback does when a write can't reuse pages
+  // because an old read snapshot still pins them. Set by the first opener.
+  // Readers are never evicted: libmdbx already clears the slots of dead
+  // processes before asking, and dropping a live reader's slot would let the
+  // writer recycle pages it is still reading.
+  enum SlowReaderPolicy { SLOW_READERS_FAIL, SLOW_READERS_LOG, SLOW_READERS_WAIT };
+  SlowReaderPolicy slowReaderPolicy = SLOW_READERS_FAIL;
+  // How long to wait for the reader to finish before giving up
+  unsigned slowReaderWaitMs = 0;
+};
 
 class MdbxEnv : public Napi::ObjectWrap<MdbxEnv> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
-  static Napi::FunctionReference constructor;
+  // One per JS thread, since each worker_thread loads its own addon instance
+  static thread_local Napi::FunctionReference constructor;
   
   MdbxEnv(const Napi::CallbackInfo& info);
   ~MdbxEnv();
 
-  // MDBX environment
-  MDBX_env* env_;
+  // MDBX environment, owned by shared_
+  MDBX_env* env_ = nullptr;
+  MdbxSharedEnv* shared_ = nullptr;
   bool isOpen_ = false;
+  // Async operations still running against env_ on the threadpool
+  int pendingAsync_ = 0;
+  // Group-commit writer, started on first use
+  std::unique_ptr<MdbxWriter> writer_;
+  // Reset read-only transactions waiting to be renewed. Reader slots are tied
+  // to the thread unless MDBX_NOTLS is used, so the pool is per Environment
+  // object rather than per shared environment.
+  std::vector<MDBX_txn*> readTxnPool_;
+  size_t readTxnPoolSize_ = 8;
 
   // Node.js methods
   Napi::Value Open(const Napi::CallbackInfo& info);
@@ -23,8 +82,26 @@ class MdbxEnv : public Napi::ObjectWrap<MdbxEnv> {
   Napi::Value Sync(const Napi::CallbackInfo& info);
   Napi::Value Stat(const Napi::CallbackInfo& info);
   Napi::Value Info(const Napi::CallbackInfo& info);
+  Napi::Value CommitStats(const Napi::CallbackInfo& info);
+  Napi::Value Metrics(const Napi::CallbackInfo& info);
+  Napi::Value Readers(const Napi::CallbackInfo& info);
+  Napi::Value CheckReaders(const Napi::CallbackInfo& info);
   void Copy(const Napi::CallbackInfo& info);
   void SetMapSize(const Napi::CallbackInfo& info);
+  Napi::Value GetAsync(const Napi::CallbackInfo& info);
+  Napi::Value PutAsync(const Napi::CallbackInfo& info);
+  Napi::Value DelAsync(const Napi::CallbackInfo& info);
+  Napi::Value WriterPut(const Napi::CallbackInfo& info);
+  Napi::Value WriterDel(const Napi::CallbackInfo& info);
+  Napi::Value WriterFlush(const Napi::CallbackInfo& info);
+
+  // Hands out a renewed read-only transaction, or null if the pool is empty
+  MDBX_txn* AcquireReadTxn();
+  // Takes back a finished read-only transaction; false if the pool is full
+  bool ReleaseReadTxn(MDBX_txn* txn, bool isReset);
+
+ private:
+  void Detach();
 };
 
 #endif // MDBX_ENV_H
\ No newline at end of file
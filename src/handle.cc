@@ -0,0 +1,189 @@
+#include "handle.h"
+#include "sharedkey.h"
+#include "core.h"
+#include <string>
+
+thread_local Napi::FunctionReference MdbxHandle::constructor;
+
+Napi::Object MdbxHandle::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "Handle", {
+    InstanceMethod("get", &MdbxHandle::Get),
+    InstanceMethod("getString", &MdbxHandle::GetString),
+    InstanceMethod("getInto", &MdbxHandle::GetInto),
+    InstanceMethod("put", &MdbxHandle::Put),
+    InstanceMethod("del", &MdbxHandle::Del)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("Handle", func);
+  return exports;
+}
+
+MdbxHandle::MdbxHandle(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<MdbxHandle>(info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Expected transaction and database objects").ThrowAsJavaScriptException();
+    return;
+  }
+
+  txn_ = Napi::ObjectWrap<MdbxTxn>::Unwrap(info[0].As<Napi::Object>());
+  dbi_ = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[1].As<Napi::Object>());
+  if (!txn_ || !dbi_) {
+    Napi::TypeError::New(env, "Expected transaction and database objects").ThrowAsJavaScriptException();
+    return;
+  }
+
+  txnRef_ = Napi::Persistent(info[0].As<Napi::Object>());
+  dbiRef_ = Napi::Persistent(info[1].As<Napi::Object>());
+}
+
+bool MdbxHandle::Usable(Napi::Env env) {
+  if (!txn_->txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return false;
+  }
+  if (!dbi_->isOpen_) {
+    Napi::Error::New(env, "Database is not open").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+// The methods below run in the caller's handle scope and only check what is
+// needed to stay memory-safe
+
+Napi::Value MdbxHandle::Get(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!Usable(env)) {
+    return env.Null();
+  }
+  MDBX_val key, data;
+  if (!SharedKey::Resolve(info[0], key)) {
+    Napi::TypeError::New(env, "Expected key buffer or string").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string scratch;
+  MdbxMetrics::Timer timer(txn_->metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_->txn_, dbi_->dbi_, dbi_->compression_.get(), key, data, scratch);
+  txn_->metrics_->Read(rc, data.iov_len);
+  if (rc == MDBX_NOTFOUND) {
+    return env.Null();
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return txn_->WrapValue(env, data);
+}
+
+Napi::Value MdbxHandle::GetString(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!Usable(env)) {
+    return env.Null();
+  }
+  MDBX_val key, data;
+  if (!SharedKey::Resolve(info[0], key)) {
+    Napi::TypeError::New(env, "Expected key buffer or string").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string scratch;
+  MdbxMetrics::Timer timer(txn_->metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_->txn_, dbi_->dbi_, dbi_->compression_.get(), key, data, scratch);
+  txn_->metrics_->Read(rc, data.iov_len);
+  if (rc == MDBX_NOTFOUND) {
+    return env.Null();
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return Napi::String::New(env, static_cast<const char*>(data.iov_base), data.iov_len);
+}
+
+Napi::Value MdbxHandle::GetInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!Usable(env)) {
+    return env.Null();
+  }
+  MDBX_val key, data;
+  char* out;
+  size_t room;
+  if (!MdbxTxn::ResolveTarget(info[1], info[2], out, room) || !SharedKey::Resolve(info[0], key)) {
+    Napi::TypeError::New(env, "Expected key, target buffer and offset within it").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string scratch;
+  MdbxMetrics::Timer timer(txn_->metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_->txn_, dbi_->dbi_, dbi_->compression_.get(), key, data, scratch);
+  txn_->metrics_->Read(rc, data.iov_len);
+  if (rc == MDBX_NOTFOUND) {
+    return env.Null();
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return MdbxTxn::CopyInto(env, data, out, room);
+}
+
+void MdbxHandle::Put(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!Usable(env)) {
+    return;
+  }
+  MDBX_val key, data;
+  if (!SharedKey::Resolve(info[0], key) || !SharedKey::ResolveValue(info[1], data)) {
+    Napi::TypeError::New(env, "Expected key and value buffer or string").ThrowAsJavaScriptException();
+    return;
+  }
+
+  unsigned int flags = info[2].IsNumber() ? info[2].As<Napi::Number>().Uint32Value() : 0;
+
+  static thread_local std::string stored;
+  // Read-only transactions are rejected by mdbx_put itself
+  MdbxMetrics::Timer timer(txn_->metrics_, MdbxMetrics::PUT);
+  int rc = MdbxCore::Put(txn_->txn_, dbi_->dbi_, dbi_->compression_.get(), key, data,
+                          static_cast<MDBX_put_flags_t>(flags), stored);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return;
+  }
+  txn_->metrics_->Wrote(data.iov_len);
+}
+
+Napi::Value MdbxHandle::Del(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (!Usable(env)) {
+    return Napi::Boolean::New(env, false);
+  }
+  MDBX_val key;
+  if (!SharedKey::Resolve(info[0], key)) {
+    Napi::TypeError::New(env, "Expected key buffer or string").ThrowAsJavaScriptException();
+    return Napi::Boolean::New(env, false);
+  }
+
+  int rc = mdbx_del(txn_->txn_, dbi_->dbi_, &key, nullptr);
+  if (rc == MDBX_NOTFOUND) {
+    return Napi::Boolean::New(env, false);
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return Napi::Boolean::New(env, false);
+  }
+  txn_->metrics_->Add(MdbxMetrics::DELS);
+  return Napi::Boolean::New(env, true);
+}
\ No newline at end of file
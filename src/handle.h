@@ -0,0 +1,38 @@
+#ifndef MDBX_HANDLE_H
+#define MDBX_HANDLE_H
+
+#include <napi.h>
+#include "mdbx_wrapper.h"
+#include "txn.h"
+#include "dbi.h"
+
+// A transaction bound to one database, created by Transaction.bind(). Its
+// get/put/del take raw key and value Buffers or strings, or the length of a
+// key in the shared key area, and skip the JS wrapper classes and most argument checks,
+// for hot loops where per-call overhead dominates.
+class MdbxHandle : public Napi::ObjectWrap<MdbxHandle> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static thread_local Napi::FunctionReference constructor;
+
+  MdbxHandle(const Napi::CallbackInfo& info);
+
+  // Node.js methods
+  Napi::Value Get(const Napi::CallbackInfo& info);
+  Napi::Value GetString(const Napi::CallbackInfo& info);
+  Napi::Value GetInto(const Napi::CallbackInfo& info);
+  void Put(const Napi::CallbackInfo& info);
+  Napi::Value Del(const Napi::CallbackInfo& info);
+
+ private:
+  // Checks that the transaction and database are still usable
+  bool Usable(Napi::Env env);
+
+  MdbxTxn* txn_ = nullptr;
+  MdbxDbi* dbi_ = nullptr;
+  // Keep the transaction and database alive for as long as this handle
+  Napi::ObjectReference txnRef_;
+  Napi::ObjectReference dbiRef_;
+};
+
+#endif // MDBX_HANDLE_H
\ No newline at end of file
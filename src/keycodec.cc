@@ -0,0 +1,289 @@
+#include "keycodec.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace KeyCodec {
+
+enum Tag : unsigned char {
+  TAG_END = 0x00,
+  TAG_NULL = 0x01,
+  TAG_FALSE = 0x02,
+  TAG_TRUE = 0x03,
+  TAG_NUMBER = 0x10,
+  TAG_BIGINT_NEG = 0x20,
+  TAG_BIGINT_ZERO = 0x21,
+  TAG_BIGINT_POS = 0x22,
+  TAG_STRING = 0x30,
+  TAG_BUFFER = 0x40,
+  TAG_ARRAY = 0x50
+};
+
+// Nesting limit for arrays, to keep malicious keys from exhausting the stack
+static const int kMaxDepth = 32;
+
+static void AppendEscaped(std::string& out, const char* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    out.push_back(data[i]);
+    if (data[i] == 0) {
+      out.push_back(static_cast<char>(0xFF));
+    }
+  }
+  out.push_back(static_cast<char>(TAG_END));
+}
+
+static bool ReadEscaped(const unsigned char* data, size_t length, size_t& offset, std::string& out) {
+  while (offset < length) {
+    unsigned char c = data[offset++];
+    if (c != 0) {
+      out.push_back(static_cast<char>(c));
+    } else if (offset < length && data[offset] == 0xFF) {
+      out.push_back(0);
+      offset++;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool EncodeValue(Napi::Env env, const Napi::Value& value, std::string& out, int depth) {
+  if (value.IsNull()) {
+    out.push_back(static_cast<char>(TAG_NULL));
+  } else if (value.IsBoolean()) {
+    out.push_back(static_cast<char>(value.As<Napi::Boolean>().Value() ? TAG_TRUE : TAG_FALSE));
+  } else if (value.IsNumber()) {
+    double number = value.As<Napi::Number>().DoubleValue();
+    if (std::isnan(number)) {
+      Napi::TypeError::New(env, "NaN cannot be used as a key").ThrowAsJavaScriptException();
+      return false;
+    }
+    if (number == 0) {
+      number = 0;  // -0 sorts with 0
+    }
+
+    uint64_t bits;
+    std::memcpy(&bits, &number, sizeof(bits));
+    bits = (bits & (1ULL << 63)) ? ~bits : bits | (1ULL << 63);
+
+    out.push_back(static_cast<char>(TAG_NUMBER));
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      out.push_back(static_cast<char>(bits >> shift));
+    }
+  } else if (value.IsBigInt()) {
+    Napi::BigInt bigint = value.As<Napi::BigInt>();
+    int sign = 0;
+    size_t wordCount = bigint.WordCount();
+    std::vector<uint64_t> words(wordCount > 0 ? wordCount : 1, 0);
+    wordCount = words.size();
+    bigint.ToWords(&sign, &wordCount, words.data());
+
+    // Big-endian magnitude without leading zero bytes
+    std::string magnitude;
+    for (size_t i = wordCount; i-- > 0;) {
+      for (int shift = 56; shift >= 0; shift -= 8) {
+        unsigned char byte = static_cast<unsigned char>(words[i] >> shift);
+        if (byte != 0 || !magnitude.empty()) {
+          magnitude.push_back(static_cast<char>(byte));
+        }
+      }
+    }
+
+    if (magnitude.empty()) {
+      out.push_back(static_cast<char>(TAG_BIGINT_ZERO));
+      return true;
+    }
+    if (magnitude.size() > 255) {
+      Napi::RangeError::New(env, "BigInt key is too large").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    // Longer magnitudes are larger, so the length goes first; for negative
+    // values everything is inverted so that larger magnitudes sort first
+    unsigned char flip = sign ? 0xFF : 0x00;
+    out.push_back(static_cast<char>(sign ? TAG_BIGINT_NEG : TAG_BIGINT_POS));
+    out.push_back(static_cast<char>(static_cast<unsigned char>(magnitude.size()) ^ flip));
+    for (char byte : magnitude) {
+      out.push_back(static_cast<char>(static_cast<unsigned char>(byte) ^ flip));
+    }
+  } else if (value.IsString()) {
+    std::string utf8 = value.As<Napi::String>().Utf8Value();
+    out.push_back(static_cast<char>(TAG_STRING));
+    AppendEscaped(out, utf8.data(), utf8.size());
+  } else if (value.IsBuffer()) {
+    Napi::Buffer<char> buffer = value.As<Napi::Buffer<char>>();
+    out.push_back(static_cast<char>(TAG_BUFFER));
+    AppendEscaped(out, buffer.Data(), buffer.Length());
+  } else if (value.IsArray()) {
+    if (depth >= kMaxDepth) {
+      Napi::RangeError::New(env, "Key arrays are nested too deeply").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    Napi::Array array = value.As<Napi::Array>();
+    out.push_back(static_cast<char>(TAG_ARRAY));
+    for (uint32_t i = 0; i < array.Length(); i++) {
+      if (!EncodeValue(env, array.Get(i), out, depth + 1)) {
+        return false;
+      }
+    }
+    out.push_back(static_cast<char>(TAG_END));
+  } else {
+    Napi::TypeError::New(env, "Unsupported key type").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+static Napi::Value DecodeValue(Napi::Env env, const unsigned char* data, size_t length,
+                               size_t& offset, int depth) {
+  if (offset >= length || depth > kMaxDepth) {
+    Napi::TypeError::New(env, "Malformed key").ThrowAsJavaScriptException();
+    return Napi::Value();
+  }
+
+  unsigned char tag = data[offset++];
+  switch (tag) {
+    case TAG_NULL:
+      return env.Null();
+    case TAG_FALSE:
+    case TAG_TRUE:
+      return Napi::Boolean::New(env, tag == TAG_TRUE);
+    case TAG_NUMBER: {
+      if (length - offset < 8) {
+        break;
+      }
+      uint64_t bits = 0;
+      for (int i = 0; i < 8; i++) {
+        bits = (bits << 8) | data[offset++];
+      }
+      bits = (bits & (1ULL << 63)) ? bits & ~(1ULL << 63) : ~bits;
+      double number;
+      std::memcpy(&number, &bits, sizeof(number));
+      return Napi::Number::New(env, number);
+    }
+    case TAG_BIGINT_ZERO:
+      return Napi::BigInt::New(env, static_cast<int64_t>(0));
+    case TAG_BIGINT_NEG:
+    case TAG_BIGINT_POS: {
+      unsigned char flip = tag == TAG_BIGINT_NEG ? 0xFF : 0x00;
+      if (offset >= length) {
+        break;
+      }
+      size_t size = data[offset++] ^ flip;
+      if (length - offset < size) {
+        break;
+      }
+      std::vector<uint64_t> words((size + 7) / 8, 0);
+      for (size_t i = 0; i < size; i++) {
+        size_t fromEnd = size - 1 - i;
+        words[fromEnd / 8] |= static_cast<uint64_t>(data[offset + i] ^ flip) << ((fromEnd % 8) * 8);
+      }
+      offset += size;
+      return Napi::BigInt::New(env, tag == TAG_BIGINT_NEG ? 1 : 0, words.size(), words.data());
+    }
+    case TAG_STRING:
+    case TAG_BUFFER: {
+      std::string bytes;
+      if (!ReadEscaped(data, length, offset, bytes)) {
+        break;
+      }
+      if (tag == TAG_STRING) {
+        return Napi::String::New(env, bytes.data(), bytes.size());
+      }
+      return Napi::Buffer<char>::Copy(env, bytes.data(), bytes.size());
+    }
+    case TAG_ARRAY: {
+      Napi::Array array = Napi::Array::New(env);
+      uint32_t index = 0;
+      while (offset < length && data[offset] != TAG_END) {
+        Napi::Value element = DecodeValue(env, data, length, offset, depth + 1);
+        if (element.IsEmpty()) {
+          return element;
+        }
+        array.Set(index++, element);
+      }
+      if (offset >= length) {
+        break;
+      }
+      offset++;
+      return array;
+    }
+    default:
+      break;
+  }
+
+  Napi::TypeError::New(env, "Malformed key").ThrowAsJavaScriptException();
+  return Napi::Value();
+}
+
+bool Encode(Napi::Env env, const Napi::Value& value, std::string& out) {
+  return EncodeValue(env, value, out, 0);
+}
+
+Napi::Value Decode(Napi::Env env, const unsigned char* data, size_t length, size_t& offset) {
+  return DecodeValue(env, data, length, offset, 0);
+}
+
+// encodeKey(value) returns a new Buffer; encodeKey(value, target, offset?)
+// writes into `target` instead and returns the number of bytes written
+static Napi::Value EncodeKey(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1) {
+    Napi::TypeError::New(env, "Expected a key").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Encoding reuses one scratch string per thread, so the only allocation is
+  // the result Buffer, and none at all when writing into `target`
+  static thread_local std::string scratch;
+  scratch.clear();
+  if (!Encode(env, info[0], scratch)) {
+    return env.Null();
+  }
+
+  if (info.Length() > 1 && info[1].IsBuffer()) {
+    Napi::Buffer<char> target = info[1].As<Napi::Buffer<char>>();
+    size_t offset = 0;
+    if (info.Length() > 2 && info[2].IsNumber()) {
+      offset = info[2].As<Napi::Number>().Uint32Value();
+    }
+    if (offset > target.Length() || target.Length() - offset < scratch.size()) {
+      Napi::RangeError::New(env, "Target buffer is too small for the key").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+    std::memcpy(target.Data() + offset, scratch.data(), scratch.size());
+    return Napi::Number::New(env, static_cast<double>(scratch.size()));
+  }
+
+  return Napi::Buffer<char>::Copy(env, scratch.data(), scratch.size());
+}
+
+static Napi::Value DecodeKey(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected a key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<unsigned char> buffer = info[0].As<Napi::Buffer<unsigned char>>();
+  size_t offset = 0;
+  Napi::Value value = Decode(env, buffer.Data(), buffer.Length(), offset);
+  if (value.IsEmpty()) {
+    return env.Null();
+  }
+  if (offset != buffer.Length()) {
+    Napi::TypeError::New(env, "Malformed key").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+  return value;
+}
+
+void Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("encodeKey", Napi::Function::New(env, EncodeKey, "encodeKey"));
+  exports.Set("decodeKey", Napi::Function::New(env, DecodeKey, "decodeKey"));
+}
+
+}  // namespace KeyCodec
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef MDBX_KEYCODEC_H
+#define MDBX_KEYCODEC_H
+
+#include <napi.h>
+#include <string>
+
+// Order-preserving key encoding: the encoded keys of two values compare
+// bytewise (MDBX's default key order) the same way the values do. Each value
+// starts with a type tag, so values of different types sort by type:
+//
+//   0x01 null, 0x02 false, 0x03 true
+//   0x10 number     float64, big-endian with the sign bit flipped (and all
+//                   bits of negative numbers inverted)
+//   0x20 negative BigInt, 0x21 zero BigInt, 0x22 positive BigInt
+//                   byte length then big-endian magnitude, inverted for
+//                   negative BigInts
+//   0x30 string     UTF-8, 0x00 escaped as 0x00 0xFF, terminated by 0x00
+//   0x40 Buffer     escaped and terminated like strings
+//   0x50 array      the encoded elements, terminated by 0x00
+namespace KeyCodec {
+
+// Appends the encoding of `value` to `out`. Throws a TypeError and returns
+// false for values that cannot be encoded.
+bool Encode(Napi::Env env, const Napi::Value& value, std::string& out);
+
+// Decodes one value starting at `offset` and advances past it. Throws and
+// returns an empty value if the bytes are malformed.
+Napi::Value Decode(Napi::Env env, const unsigned char* data, size_t length, size_t& offset);
+
+// Exports encodeKey() and decodeKey()
+void Init(Napi::Env env, Napi::Object exports);
+
+}  // namespace KeyCodec
+
+#endif // MDBX_KEYCODEC_H
\ No newline at end of file
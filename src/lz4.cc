@@ -0,0 +1,335 @@
+#include "lz4.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Lz4 {
+
+static const int kHashLog = 12;
+static const size_t kMinMatch = 4;
+// The last match must start 12 bytes before the end of the block and the
+// last 5 bytes are always literals
+static const size_t kMatchStartLimit = 12;
+static const size_t kLastLiterals = 5;
+static const size_t kMaxOffset = 65535;
+static const uint32_t kNoPosition = 0xFFFFFFFF;
+
+static inline uint32_t Read32(const unsigned char* p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline uint32_t Hash(uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+size_t CompressBound(size_t length) {
+  return length + length / 255 + 16;
+}
+
+// Writes a literal or match length continuation: bytes of 255 and a remainder
+static inline bool WriteLength(unsigned char*& op, const unsigned char* oend, size_t length) {
+  while (length >= 255) {
+    if (op >= oend) {
+      return false;
+    }
+    *op++ = 255;
+    length -= 255;
+  }
+  if (op >= oend) {
+    return false;
+  }
+  *op++ = static_cast<unsigned char>(length);
+  return true;
+}
+
+static bool WriteSequence(unsigned char*& op, const unsigned char* oend,
+                          const unsigned char* literals, size_t literalLength,
+                          size_t offset, size_t matchLength) {
+  if (op >= oend) {
+    return false;
+  }
+  unsigned char* token = op++;
+  *token = static_cast<unsigned char>((literalLength >= 15 ? 15 : literalLength) << 4);
+  if (literalLength >= 15 && !WriteLength(op, oend, literalLength - 15)) {
+    return false;
+  }
+  if (static_cast<size_t>(oend - op) < literalLength) {
+    return false;
+  }
+  std::memcpy(op, literals, literalLength);
+  op += literalLength;
+
+  // The final sequence has literals only
+  if (matchLength == 0) {
+    return true;
+  }
+
+  if (oend - op < 2) {
+    return false;
+  }
+  *op++ = static_cast<unsigned char>(offset);
+  *op++ = static_cast<unsigned char>(offset >> 8);
+  size_t extra = matchLength - kMinMatch;
+  *token |= static_cast<unsigned char>(extra >= 15 ? 15 : extra);
+  return extra < 15 || WriteLength(op, oend, extra - 15);
+}
+
+size_t Compress(const char* src, size_t length, char* dst, size_t capacity,
+                const char* dict, size_t dictLength) {
+  // Matches into the dictionary are found by compressing over the
+  // dictionary's tail followed by the input
+  if (dictLength > kMaxOffset) {
+    dict += dictLength - kMaxOffset;
+    dictLength = kMaxOffset;
+  }
+  static thread_local std::string window;
+  const unsigned char* base = reinterpret_cast<const unsigned char*>(src);
+  if (dictLength > 0) {
+    window.assign(dict, dictLength);
+    window.append(src, length);
+    base = reinterpret_cast<const unsigned char*>(window.data());
+  }
+
+  uint32_t table[1 << kHashLog];
+  std::fill(table, table + (1 << kHashLog), kNoPosition);
+  for (size_t pos = 0; pos + kMinMatch <= dictLength; pos++) {
+    table[Hash(Read32(base + pos))] = static_cast<uint32_t>(pos);
+  }
+
+  unsigned char* op = reinterpret_cast<unsigned char*>(dst);
+  const unsigned char* oend = op + capacity;
+  size_t start = dictLength;
+  size_t end = dictLength + length;
+  size_t anchor = start;
+  size_t ip = start;
+
+  if (length >= kMatchStartLimit + 1) {
+    size_t matchStartLimit = end - kMatchStartLimit;
+    size_t matchEndLimit = end - kLastLiterals;
+
+    while (ip < matchStartLimit) {
+      uint32_t sequence = Read32(base + ip);
+      uint32_t h = Hash(sequence);
+      size_t ref = table[h];
+      table[h] = static_cast<uint32_t>(ip);
+
+      if (ref == kNoPosition || ip - ref > kMaxOffset || Read32(base + ref) != sequence) {
+        // Skip faster through data that doesn't compress
+        ip += 1 + ((ip - anchor) >> 6);
+        continue;
+      }
+
+      size_t matchLength = kMinMatch;
+      while (ip + matchLength < matchEndLimit && base[ref + matchLength] == base[ip + matchLength]) {
+        matchLength++;
+      }
+      while (ip > anchor && ref > 0 && base[ip - 1] == base[ref - 1]) {
+        ip--;
+        ref--;
+        matchLength++;
+      }
+
+      if (!WriteSequence(op, oend, base + anchor, ip - anchor, ip - ref, matchLength)) {
+        return 0;
+      }
+      ip += matchLength;
+      anchor = ip;
+      if (ip < matchStartLimit) {
+        table[Hash(Read32(base + ip - 2))] = static_cast<uint32_t>(ip - 2);
+      }
+    }
+  }
+
+  if (!WriteSequence(op, oend, base + anchor, end - anchor, 0, 0)) {
+    return 0;
+  }
+  return op - reinterpret_cast<unsigned char*>(dst);
+}
+
+static inline bool ReadLength(const unsigned char*& ip, const unsigned char* iend, size_t& length) {
+  unsigned char c;
+  do {
+    if (ip >= iend) {
+      return false;
+    }
+    c = *ip++;
+    length += c;
+  } while (c == 255);
+  return true;
+}
+
+bool Decompress(const char* src, size_t srcLength, char* dst, size_t length,
+                const char* dict, size_t dictLength) {
+  const unsigned char* ip = reinterpret_cast<const unsigned char*>(src);
+  const unsigned char* iend = ip + srcLength;
+  size_t op = 0;
+
+  for (;;) {
+    if (ip >= iend) {
+      return false;
+    }
+    unsigned char token = *ip++;
+
+    size_t literalLength = token >> 4;
+    if (literalLength == 15 && !ReadLength(ip, iend, literalLength)) {
+      return false;
+    }
+    if (literalLength > static_cast<size_t>(iend - ip) || literalLength > length - op) {
+      return false;
+    }
+    std::memcpy(dst + op, ip, literalLength);
+    ip += literalLength;
+    op += literalLength;
+
+    if (ip == iend) {
+      return op == length;
+    }
+
+    if (iend - ip < 2) {
+      return false;
+    }
+    size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+    ip += 2;
+    size_t matchLength = token & 15;
+    if (matchLength == 15 && !ReadLength(ip, iend, matchLength)) {
+      return false;
+    }
+    matchLength += kMinMatch;
+    if (offset == 0 || matchLength > length - op) {
+      return false;
+    }
+
+    if (offset > op) {
+      // The match starts in the dictionary and may run on into the output
+      size_t back = offset - op;
+      if (back > dictLength) {
+        return false;
+      }
+      size_t fromDict = std::min(back, matchLength);
+      std::memcpy(dst + op, dict + dictLength - back, fromDict);
+      op += fromDict;
+      matchLength -= fromDict;
+      if (matchLength == 0) {
+        continue;
+      }
+      // What remains continues from the start of the output
+      for (size_t i = 0; i < matchLength; i++) {
+        dst[op + i] = dst[i];
+      }
+      op += matchLength;
+    } else if (offset >= matchLength) {
+      std::memcpy(dst + op, dst + op - offset, matchLength);
+      op += matchLength;
+    } else {
+      // Overlapping matches repeat the last `offset` bytes
+      for (size_t i = 0; i < matchLength; i++, op++) {
+        dst[op] = dst[op - offset];
+      }
+    }
+  }
+}
+
+// Substring length whose recurrence is counted, and the length of the
+// segments the dictionary is built from
+static const size_t kDmer = 8;
+static const size_t kSegment = 64;
+
+static inline uint64_t HashDmer(const unsigned char* p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v * 0x9E3779B97F4A7C15ull;
+}
+
+std::string TrainDictionary(const std::vector<std::string>& samples, size_t maxSize) {
+  // Number of samples each substring occurs in. Substrings found in a single
+  // sample are worthless to a dictionary.
+  std::string all;
+  std::vector<uint64_t> dmers;
+  std::unordered_map<uint64_t, uint32_t> frequency;
+  for (const std::string& sample : samples) {
+    std::unordered_set<uint64_t> seen;
+    size_t offset = all.size();
+    all.append(sample);
+    for (size_t i = 0; i < sample.size(); i++) {
+      uint64_t dmer = 0;
+      if (i + kDmer <= sample.size()) {
+        dmer = HashDmer(reinterpret_cast<const unsigned char*>(all.data()) + offset + i);
+        if (seen.insert(dmer).second) {
+          frequency[dmer]++;
+        }
+      }
+      dmers.push_back(dmer);
+    }
+  }
+  if (all.size() < kSegment || maxSize == 0) {
+    return std::string();
+  }
+
+  auto score = [&](uint64_t dmer) -> uint64_t {
+    if (dmer == 0) {
+      return 0;
+    }
+    auto it = frequency.find(dmer);
+    return it == frequency.end() || it->second < 2 ? 0 : it->second;
+  };
+
+  // The input is split into one epoch per segment the dictionary can hold,
+  // and the best-scoring segment of each epoch is kept. Substrings already
+  // covered stop counting, so later segments add something new.
+  size_t epochs = std::max<size_t>(1, std::min(maxSize / kSegment, all.size() / kSegment));
+  size_t epochSize = all.size() / epochs;
+  struct Pick {
+    uint64_t score;
+    size_t begin;
+  };
+  std::vector<Pick> picks;
+
+  for (size_t epoch = 0; epoch < epochs; epoch++) {
+    size_t begin = epoch * epochSize;
+    size_t end = std::min(all.size(), begin + epochSize);
+    if (end - begin < kSegment) {
+      continue;
+    }
+
+    uint64_t window = 0;
+    for (size_t i = begin; i < begin + kSegment - kDmer + 1; i++) {
+      window += score(dmers[i]);
+    }
+    Pick best = {window, begin};
+    for (size_t pos = begin + 1; pos + kSegment <= end; pos++) {
+      window -= score(dmers[pos - 1]);
+      window += score(dmers[pos + kSegment - kDmer]);
+      if (window > best.score) {
+        best = {window, pos};
+      }
+    }
+
+    if (best.score == 0) {
+      continue;
+    }
+    for (size_t i = best.begin; i < best.begin + kSegment; i++) {
+      if (dmers[i] != 0) {
+        frequency.erase(dmers[i]);
+      }
+    }
+    picks.push_back(best);
+  }
+
+  std::stable_sort(picks.begin(), picks.end(), [](const Pick& a, const Pick& b) {
+    return a.score < b.score;
+  });
+  std::string dictionary;
+  for (const Pick& pick : picks) {
+    dictionary.append(all, pick.begin, kSegment);
+  }
+  if (dictionary.size() > maxSize) {
+    dictionary.erase(0, dictionary.size() - maxSize);
+  }
+  return dictionary;
+}
+
+}  // namespace Lz4
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef MDBX_LZ4_H
+#define MDBX_LZ4_H
+
+#include <string>
+#include <vector>
+
+// LZ4 block format codec, with optional dictionaries: a dictionary acts as
+// data preceding the block, so matches may reach back into it. The output is
+// a raw LZ4 block, interchangeable with LZ4_compress_fast_continue() and
+// LZ4_decompress_safe_usingDict().
+namespace Lz4 {
+
+// Worst-case compressed size of `length` bytes
+size_t CompressBound(size_t length);
+
+// Compresses `src` into `dst`. Returns the compressed size, or 0 if the
+// result does not fit in `capacity`.
+size_t Compress(const char* src, size_t length, char* dst, size_t capacity,
+                const char* dict = nullptr, size_t dictLength = 0);
+
+// Decompresses a block that expands to exactly `length` bytes. Returns false
+// if the block is malformed or expands to any other size.
+bool Decompress(const char* src, size_t srcLength, char* dst, size_t length,
+                const char* dict = nullptr, size_t dictLength = 0);
+
+// Builds a dictionary of at most `maxSize` bytes from sample values, out of
+// the segments whose substrings recur across the most samples. The most
+// useful segments are placed last, closest to the data.
+std::string TrainDictionary(const std::vector<std::string>& samples, size_t maxSize);
+
+}  // namespace Lz4
+
+#endif // MDBX_LZ4_H
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "txn.h"
 #include "dbi.h"
 #include "cursor.h"
+#include "handle.h"
+#include "keycodec.h"
+#include "msgpack.h"
+#include "sharedkey.h"
 
 Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
   // Initialize all classes
@@ -10,6 +14,10 @@ Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
   MdbxTxn::Init(env, exports);
   MdbxDbi::Init(env, exports);
   MdbxCursor::Init(env, exports);
+  MdbxHandle::Init(env, exports);
+  KeyCodec::Init(env, exports);
+  Msgpack::Init(env, exports);
+  SharedKey::Init(env, exports);
 
   // Define enum values
   Napi::Object envFlags = Napi::Object::New(env);
@@ -51,6 +59,12 @@ Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
   txnMode.Set("READWRITE", Napi::Number::New(env, 1));
   exports.Set("TransactionMode", txnMode);
 
+  Napi::Object txnFlags = Napi::Object::New(env);
+  txnFlags.Set("NOSYNC", Napi::Number::New(env, MDBX_TXN_NOSYNC));
+  txnFlags.Set("NOMETASYNC", Napi::Number::New(env, MDBX_TXN_NOMETASYNC));
+  txnFlags.Set("TRY", Napi::Number::New(env, MDBX_TXN_TRY));
+  exports.Set("TxnFlags", txnFlags);
+
   Napi::Object seekOp = Napi::Object::New(env);
   seekOp.Set("FIRST", Napi::Number::New(env, MDBX_FIRST));
   seekOp.Set("FIRST_DUP", Napi::Number::New(env, MDBX_FIRST_DUP));
@@ -0,0 +1,134 @@
+#include "metrics.h"
+#include "env.h"
+
+const char* const MdbxMetrics::kCounterNames[COUNTERS] = {
+  "gets", "hits", "misses", "puts", "dels", "bytesRead", "bytesWritten",
+  "txnsBegun", "txnsCommitted", "txnsAborted", "cursorSteps", "slowReaders"
+};
+
+const char* const MdbxMetrics::kHistogramNames[HISTOGRAMS] = {
+  "get", "put", "commit"
+};
+
+MdbxMetrics* MdbxMetrics::Of(MDBX_txn* txn) {
+  return Of(mdbx_txn_env(txn));
+}
+
+MdbxMetrics* MdbxMetrics::Of(MDBX_env* env) {
+  MdbxSharedEnv* shared = env ? static_cast<MdbxSharedEnv*>(mdbx_env_get_userctx(env)) : nullptr;
+  return shared ? &shared->metrics : nullptr;
+}
+
+unsigned MdbxMetrics::ThreadShard() {
+  // Threads are dealt shards round-robin the first time they record anything
+  static std::atomic<unsigned> next{0};
+  static thread_local unsigned shard = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+  return shard;
+}
+
+int MdbxMetrics::BucketOf(uint64_t ns) {
+  if (ns < kSubBuckets) {
+    return static_cast<int>(ns);
+  }
+  int exponent = 63;
+  while (!(ns >> exponent)) {
+    exponent--;
+  }
+  int bucket = (exponent - 2) * kSubBuckets + static_cast<int>((ns >> (exponent - 3)) & (kSubBuckets - 1));
+  return bucket < kBuckets ? bucket : kBuckets - 1;
+}
+
+double MdbxMetrics::BucketValue(int bucket) {
+  if (bucket < kSubBuckets) {
+    return bucket;
+  }
+  int shift = bucket / kSubBuckets - 1;
+  double low = static_cast<double>(uint64_t(kSubBuckets + bucket % kSubBuckets) << shift);
+  return low + static_cast<double>(uint64_t(1) << shift) / 2;
+}
+
+void MdbxMetrics::Record(Histogram histogram, uint64_t ns) {
+  Shard& shard = Local();
+  shard.buckets[histogram][BucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+  shard.totalNs[histogram].fetch_add(ns, std::memory_order_relaxed);
+  uint64_t max = shard.maxNs[histogram].load(std::memory_order_relaxed);
+  while (ns > max && !shard.maxNs[histogram].compare_exchange_weak(max, ns, std::memory_order_relaxed)) {
+  }
+}
+
+uint64_t MdbxMetrics::Read(Counter counter) const {
+  uint64_t total = 0;
+  for (const Shard& shard : shards_) {
+    total += shard.counters[counter].load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+MdbxMetrics::Summary MdbxMetrics::Summarize(Histogram histogram) const {
+  Summary summary;
+  uint64_t buckets[kBuckets] = {};
+  uint64_t totalNs = 0;
+  for (const Shard& shard : shards_) {
+    for (int i = 0; i < kBuckets; i++) {
+      buckets[i] += shard.buckets[histogram][i].load(std::memory_order_relaxed);
+    }
+    totalNs += shard.totalNs[histogram].load(std::memory_order_relaxed);
+    uint64_t max = shard.maxNs[histogram].load(std::memory_order_relaxed);
+    summary.maxNs = max > summary.maxNs ? max : summary.maxNs;
+  }
+  for (int i = 0; i < kBuckets; i++) {
+    summary.count += buckets[i];
+  }
+  if (summary.count == 0) {
+    return summary;
+  }
+  summary.meanNs = static_cast<double>(totalNs) / static_cast<double>(summary.count);
+
+  const double quantiles[] = { 0.5, 0.9, 0.99, 0.999 };
+  double* results[] = { &summary.p50Ns, &summary.p90Ns, &summary.p99Ns, &summary.p999Ns };
+  uint64_t seen = 0;
+  int bucket = 0;
+  for (int q = 0; q < 4; q++) {
+    uint64_t rank = static_cast<uint64_t>(quantiles[q] * static_cast<double>(summary.count));
+    if (rank == 0) {
+      rank = 1;
+    }
+    while (bucket < kBuckets - 1 && seen + buckets[bucket] < rank) {
+      seen += buckets[bucket++];
+    }
+    double value = BucketValue(bucket);
+    *results[q] = value < static_cast<double>(summary.maxNs) ? value : static_cast<double>(summary.maxNs);
+  }
+  return summary;
+}
+
+void MdbxMetrics::Reset() {
+  for (Shard& shard : shards_) {
+    for (std::atomic<uint64_t>& counter : shard.counters) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+    for (int h = 0; h < HISTOGRAMS; h++) {
+      for (std::atomic<uint64_t>& bucket : shard.buckets[h]) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+      shard.totalNs[h].store(0, std::memory_order_relaxed);
+      shard.maxNs[h].store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+MdbxMetrics::Timer::Timer(MdbxMetrics* metrics, Histogram histogram)
+  : metrics_(nullptr), histogram_(histogram) {
+  static thread_local unsigned tick = 0;
+  if (metrics && ++tick % kSampleEvery == 0) {
+    metrics_ = metrics;
+    start_ = std::chrono::steady_clock::now();
+  }
+}
+
+MdbxMetrics::Timer::~Timer() {
+  if (metrics_) {
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start_;
+    metrics_->Record(histogram_, static_cast<uint64_t>(elapsed.count()));
+  }
+}
\ No newline at end of file
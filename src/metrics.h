@@ -0,0 +1,113 @@
+#ifndef MDBX_METRICS_H
+#define MDBX_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include "mdbx_wrapper.h"
+
+// Operation counters and latency histograms of one shared environment.
+//
+// Updates land in one of kShards cache-line aligned shards, picked once per
+// thread, so JS threads, the writer thread and the threadpool rarely touch
+// the same lines; readers sum the shards. Histograms are log-linear like
+// HdrHistogram: each power of two is split into 8 sub-buckets, giving about
+// 12% precision over nanoseconds to minutes. Gets and puts are timed one in
+// kSampleEvery calls to keep clock reads off most of the hot path; commits
+// are always recorded, from the latency libmdbx reports.
+class MdbxMetrics {
+ public:
+  enum Counter {
+    GETS, HITS, MISSES, PUTS, DELS, BYTES_READ, BYTES_WRITTEN,
+    TXNS_BEGUN, TXNS_COMMITTED, TXNS_ABORTED, CURSOR_STEPS, SLOW_READERS,
+    COUNTERS
+  };
+  static const char* const kCounterNames[COUNTERS];
+
+  enum Histogram { GET, PUT, COMMIT, HISTOGRAMS };
+  static const char* const kHistogramNames[HISTOGRAMS];
+
+  static const int kShards = 16;
+  static const int kSubBuckets = 8;
+  // Enough for durations up to 2^42 ns, over an hour
+  static const int kBuckets = 40 * kSubBuckets;
+  static const unsigned kSampleEvery = 8;
+
+  // Summary of one histogram, durations in nanoseconds
+  struct Summary {
+    uint64_t count = 0;
+    double meanNs = 0;
+    uint64_t maxNs = 0;
+    double p50Ns = 0;
+    double p90Ns = 0;
+    double p99Ns = 0;
+    double p999Ns = 0;
+  };
+
+  // The metrics of the environment `txn` or `env` belongs to, or null if it
+  // wasn't opened by this binding
+  static MdbxMetrics* Of(MDBX_txn* txn);
+  static MdbxMetrics* Of(MDBX_env* env);
+
+  void Add(Counter counter, uint64_t amount = 1) {
+    Local().counters[counter].fetch_add(amount, std::memory_order_relaxed);
+  }
+
+  // Counts a point read finishing with `rc`, of `bytes` when found
+  void Read(int rc, size_t bytes) {
+    Shard& shard = Local();
+    shard.counters[GETS].fetch_add(1, std::memory_order_relaxed);
+    if (rc == MDBX_SUCCESS) {
+      shard.counters[HITS].fetch_add(1, std::memory_order_relaxed);
+      shard.counters[BYTES_READ].fetch_add(bytes, std::memory_order_relaxed);
+    } else if (rc == MDBX_NOTFOUND) {
+      shard.counters[MISSES].fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  // Counts a write of `bytes`
+  void Wrote(size_t bytes) {
+    Shard& shard = Local();
+    shard.counters[PUTS].fetch_add(1, std::memory_order_relaxed);
+    shard.counters[BYTES_WRITTEN].fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  void Record(Histogram histogram, uint64_t ns);
+
+  uint64_t Read(Counter counter) const;
+  Summary Summarize(Histogram histogram) const;
+  void Reset();
+
+  // Times a get or put for its histogram, sampling one in kSampleEvery.
+  // Does nothing when `metrics` is null.
+  class Timer {
+   public:
+    Timer(MdbxMetrics* metrics, Histogram histogram);
+    ~Timer();
+
+   private:
+    MdbxMetrics* metrics_;
+    Histogram histogram_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+ private:
+  struct alignas(64) Shard {
+    std::atomic<uint64_t> counters[COUNTERS] = {};
+    std::atomic<uint64_t> buckets[HISTOGRAMS][kBuckets] = {};
+    std::atomic<uint64_t> totalNs[HISTOGRAMS] = {};
+    std::atomic<uint64_t> maxNs[HISTOGRAMS] = {};
+  };
+
+  static int BucketOf(uint64_t ns);
+  // Midpoint of the durations counted in `bucket`
+  static double BucketValue(int bucket);
+  static unsigned ThreadShard();
+
+  Shard& Local() { return shards_[ThreadShard()]; }
+
+  Shard shards_[kShards];
+};
+
+#endif // MDBX_METRICS_H
\ No newline at end of file
@@ -0,0 +1,620 @@
+#include "msgpack.h"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace Msgpack {
+
+enum ExtType : int8_t {
+  EXT_TIMESTAMP = -1,
+  EXT_BIGINT = 1,
+  EXT_MAP = 2,
+  EXT_TYPED_ARRAY = 3,
+  EXT_RECORD = 4
+};
+
+// Nesting limit, which also catches cyclic structures
+static const int kMaxDepth = 256;
+
+class Encoder {
+ public:
+  Encoder(Napi::Env env, std::string& out, Structures* structures)
+    : env_(env), out_(out), structures_(structures) {}
+
+  bool Encode(const Napi::Value& value, int depth) {
+    if (depth > kMaxDepth) {
+      Napi::RangeError::New(env_, "Value is nested too deeply or cyclic").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    if (value.IsNull() || value.IsUndefined() || value.IsFunction() || value.IsSymbol()) {
+      Byte(0xc0);
+    } else if (value.IsBoolean()) {
+      Byte(value.As<Napi::Boolean>().Value() ? 0xc3 : 0xc2);
+    } else if (value.IsNumber()) {
+      Number(value.As<Napi::Number>().DoubleValue());
+    } else if (value.IsString()) {
+      std::string utf8 = value.As<Napi::String>().Utf8Value();
+      StrHeader(utf8.size());
+      out_.append(utf8);
+    } else if (value.IsBigInt()) {
+      return BigInt(value.As<Napi::BigInt>());
+    } else if (value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+      // Checked before IsBuffer(), which is true for every ArrayBufferView
+      TypedArray(value.As<Napi::TypedArray>());
+    } else if (value.IsBuffer()) {
+      Napi::Buffer<char> buffer = value.As<Napi::Buffer<char>>();
+      BinHeader(buffer.Length());
+      out_.append(buffer.Data(), buffer.Length());
+    } else if (value.IsDate()) {
+      Date(value.As<Napi::Date>().ValueOf());
+    } else if (value.IsArray()) {
+      Napi::Array array = value.As<Napi::Array>();
+      uint32_t length = array.Length();
+      ArrayHeader(length);
+      for (uint32_t i = 0; i < length; i++) {
+        if (!Encode(array.Get(i), depth + 1)) {
+          return false;
+        }
+      }
+    } else if (value.IsObject()) {
+      Napi::Object object = value.As<Napi::Object>();
+      if (IsMap(object)) {
+        return Map(object, depth);
+      }
+      return Object(object, depth);
+    } else {
+      Napi::TypeError::New(env_, "Unsupported value type").ThrowAsJavaScriptException();
+      return false;
+    }
+    return true;
+  }
+
+ private:
+  void Byte(uint8_t byte) {
+    out_.push_back(static_cast<char>(byte));
+  }
+
+  void BigEndian(uint64_t value, int bytes) {
+    for (int shift = (bytes - 1) * 8; shift >= 0; shift -= 8) {
+      Byte(static_cast<uint8_t>(value >> shift));
+    }
+  }
+
+  void Number(double number) {
+    // Integers that doubles represent exactly use the compact integer forms
+    if (std::isfinite(number) && std::trunc(number) == number &&
+        std::fabs(number) <= 9007199254740991.0 && !(number == 0 && std::signbit(number))) {
+      if (number >= 0) {
+        uint64_t n = static_cast<uint64_t>(number);
+        if (n < 0x80) {
+          Byte(static_cast<uint8_t>(n));
+        } else if (n <= 0xff) {
+          Byte(0xcc); BigEndian(n, 1);
+        } else if (n <= 0xffff) {
+          Byte(0xcd); BigEndian(n, 2);
+        } else if (n <= 0xffffffffULL) {
+          Byte(0xce); BigEndian(n, 4);
+        } else {
+          Byte(0xcf); BigEndian(n, 8);
+        }
+      } else {
+        int64_t n = static_cast<int64_t>(number);
+        if (n >= -32) {
+          Byte(static_cast<uint8_t>(n));
+        } else if (n >= -128) {
+          Byte(0xd0); BigEndian(static_cast<uint64_t>(n), 1);
+        } else if (n >= -32768) {
+          Byte(0xd1); BigEndian(static_cast<uint64_t>(n), 2);
+        } else if (n >= -2147483648LL) {
+          Byte(0xd2); BigEndian(static_cast<uint64_t>(n), 4);
+        } else {
+          Byte(0xd3); BigEndian(static_cast<uint64_t>(n), 8);
+        }
+      }
+      return;
+    }
+
+    float single = static_cast<float>(number);
+    if (static_cast<double>(single) == number || std::isnan(number)) {
+      uint32_t bits;
+      std::memcpy(&bits, &single, sizeof(bits));
+      Byte(0xca); BigEndian(bits, 4);
+    } else {
+      uint64_t bits;
+      std::memcpy(&bits, &number, sizeof(bits));
+      Byte(0xcb); BigEndian(bits, 8);
+    }
+  }
+
+  void StrHeader(size_t length) {
+    if (length < 32) {
+      Byte(static_cast<uint8_t>(0xa0 | length));
+    } else if (length <= 0xff) {
+      Byte(0xd9); BigEndian(length, 1);
+    } else if (length <= 0xffff) {
+      Byte(0xda); BigEndian(length, 2);
+    } else {
+      Byte(0xdb); BigEndian(length, 4);
+    }
+  }
+
+  void BinHeader(size_t length) {
+    if (length <= 0xff) {
+      Byte(0xc4); BigEndian(length, 1);
+    } else if (length <= 0xffff) {
+      Byte(0xc5); BigEndian(length, 2);
+    } else {
+      Byte(0xc6); BigEndian(length, 4);
+    }
+  }
+
+  void ArrayHeader(size_t length) {
+    if (length < 16) {
+      Byte(static_cast<uint8_t>(0x90 | length));
+    } else if (length <= 0xffff) {
+      Byte(0xdc); BigEndian(length, 2);
+    } else {
+      Byte(0xdd); BigEndian(length, 4);
+    }
+  }
+
+  void MapHeader(size_t length) {
+    if (length < 16) {
+      Byte(static_cast<uint8_t>(0x80 | length));
+    } else if (length <= 0xffff) {
+      Byte(0xde); BigEndian(length, 2);
+    } else {
+      Byte(0xdf); BigEndian(length, 4);
+    }
+  }
+
+  void ExtHeader(int8_t type, size_t length) {
+    if (length <= 0xff) {
+      Byte(0xc7); BigEndian(length, 1);
+    } else if (length <= 0xffff) {
+      Byte(0xc8); BigEndian(length, 2);
+    } else {
+      Byte(0xc9); BigEndian(length, 4);
+    }
+    Byte(static_cast<uint8_t>(type));
+  }
+
+  // Starts an extension whose length is only known once its payload has been
+  // written, returning where its header begins
+  size_t BeginExt(int8_t type) {
+    size_t start = out_.size();
+    Byte(0xc9);
+    BigEndian(0, 4);
+    Byte(static_cast<uint8_t>(type));
+    return start;
+  }
+
+  // Fills in the length, shrinking the header to the 8-bit form when the
+  // payload is short, as it is for most records
+  void EndExt(size_t start) {
+    size_t length = out_.size() - start - 6;
+    if (length <= 0xff) {
+      out_[start] = static_cast<char>(0xc7);
+      out_[start + 1] = static_cast<char>(length);
+      out_[start + 2] = out_[start + 5];
+      out_.erase(start + 3, 3);
+      return;
+    }
+    for (int i = 0; i < 4; i++) {
+      out_[start + 1 + i] = static_cast<char>(length >> ((3 - i) * 8));
+    }
+  }
+
+  void Date(double ms) {
+    if (!std::isfinite(ms)) {
+      Byte(0xc0);  // Invalid Date, as JSON.stringify does
+      return;
+    }
+    double seconds = std::floor(ms / 1000);
+    uint32_t nanoseconds = static_cast<uint32_t>((ms - seconds * 1000) * 1000000);
+    ExtHeader(EXT_TIMESTAMP, 12);
+    BigEndian(nanoseconds, 4);
+    BigEndian(static_cast<uint64_t>(static_cast<int64_t>(seconds)), 8);
+  }
+
+  bool BigInt(Napi::BigInt bigint) {
+    int sign = 0;
+    size_t wordCount = bigint.WordCount();
+    std::vector<uint64_t> words(wordCount > 0 ? wordCount : 1, 0);
+    wordCount = words.size();
+    bigint.ToWords(&sign, &wordCount, words.data());
+
+    std::string magnitude;
+    for (size_t i = wordCount; i-- > 0;) {
+      for (int shift = 56; shift >= 0; shift -= 8) {
+        uint8_t byte = static_cast<uint8_t>(words[i] >> shift);
+        if (byte != 0 || !magnitude.empty()) {
+          magnitude.push_back(static_cast<char>(byte));
+        }
+      }
+    }
+
+    ExtHeader(EXT_BIGINT, 1 + magnitude.size());
+    Byte(sign ? 1 : 0);
+    out_.append(magnitude);
+    return true;
+  }
+
+  void TypedArray(Napi::TypedArray array) {
+    Napi::ArrayBuffer buffer = array.ArrayBuffer();
+    const char* data = static_cast<const char*>(buffer.Data()) + array.ByteOffset();
+    ExtHeader(EXT_TYPED_ARRAY, 1 + array.ByteLength());
+    Byte(static_cast<uint8_t>(array.TypedArrayType()));
+    out_.append(data, array.ByteLength());
+  }
+
+  bool IsMap(const Napi::Object& object) {
+    if (map_.IsEmpty()) {
+      map_ = env_.Global().Get("Map").As<Napi::Function>();
+    }
+    return object.InstanceOf(map_);
+  }
+
+  bool Map(const Napi::Object& map, int depth) {
+    Napi::Function from = env_.Global().Get("Array").As<Napi::Object>().Get("from").As<Napi::Function>();
+    Napi::Value entries = from.Call({map});
+    if (env_.IsExceptionPending()) {
+      return false;
+    }
+
+    size_t start = BeginExt(EXT_MAP);
+    if (!Encode(entries, depth + 1)) {
+      return false;
+    }
+    EndExt(start);
+    return true;
+  }
+
+  bool Object(const Napi::Object& object, int depth) {
+    Napi::Array names = object.GetPropertyNames();
+    std::vector<std::pair<Napi::Value, Napi::Value>> fields;
+    fields.reserve(names.Length());
+    for (uint32_t i = 0; i < names.Length(); i++) {
+      Napi::Value name = names.Get(i);
+      Napi::Value field = object.Get(name);
+      if (field.IsUndefined() || field.IsFunction() || field.IsSymbol()) {
+        continue;
+      }
+      fields.emplace_back(name, field);
+    }
+
+    if (structures_ && !fields.empty()) {
+      std::vector<std::string> names;
+      names.reserve(fields.size());
+      for (auto& field : fields) {
+        names.push_back(field.first.ToString().Utf8Value());
+      }
+
+      uint32_t id;
+      if (structures_->IdFor(env_, names, id)) {
+        size_t start = BeginExt(EXT_RECORD);
+        Number(id);
+        for (auto& field : fields) {
+          if (!Encode(field.second, depth + 1)) {
+            return false;
+          }
+        }
+        EndExt(start);
+        return true;
+      }
+      if (env_.IsExceptionPending()) {
+        return false;
+      }
+    }
+
+    MapHeader(fields.size());
+    for (auto& field : fields) {
+      std::string name = field.first.ToString().Utf8Value();
+      StrHeader(name.size());
+      out_.append(name);
+      if (!Encode(field.second, depth + 1)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  Napi::Env env_;
+  std::string& out_;
+  Structures* structures_;
+  Napi::Function map_;
+};
+
+class Decoder {
+ public:
+  Decoder(Napi::Env env, const unsigned char* data, size_t length, Structures* structures)
+    : env_(env), data_(data), length_(length), structures_(structures) {}
+
+  Napi::Value Decode(int depth) {
+    if (depth > kMaxDepth || !Has(1)) {
+      return Fail();
+    }
+
+    uint8_t type = data_[offset_++];
+    if (type <= 0x7f) {
+      return Napi::Number::New(env_, type);
+    } else if (type >= 0xe0) {
+      return Napi::Number::New(env_, static_cast<int8_t>(type));
+    } else if ((type & 0xe0) == 0xa0) {
+      return String(type & 0x1f);
+    } else if ((type & 0xf0) == 0x90) {
+      return Array(type & 0x0f, depth);
+    } else if ((type & 0xf0) == 0x80) {
+      return Map(type & 0x0f, depth);
+    }
+
+    switch (type) {
+      case 0xc0: return env_.Null();
+      case 0xc2: return Napi::Boolean::New(env_, false);
+      case 0xc3: return Napi::Boolean::New(env_, true);
+      case 0xc4: return Has(1) ? Bin(ReadUint(1)) : Fail();
+      case 0xc5: return Has(2) ? Bin(ReadUint(2)) : Fail();
+      case 0xc6: return Has(4) ? Bin(ReadUint(4)) : Fail();
+      case 0xc7: return Has(1) ? Ext(ReadUint(1), depth) : Fail();
+      case 0xc8: return Has(2) ? Ext(ReadUint(2), depth) : Fail();
+      case 0xc9: return Has(4) ? Ext(ReadUint(4), depth) : Fail();
+      case 0xca: {
+        if (!Has(4)) return Fail();
+        uint32_t bits = static_cast<uint32_t>(ReadUint(4));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return Napi::Number::New(env_, value);
+      }
+      case 0xcb: {
+        if (!Has(8)) return Fail();
+        uint64_t bits = ReadUint(8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return Napi::Number::New(env_, value);
+      }
+      case 0xcc: return Has(1) ? Napi::Number::New(env_, static_cast<double>(ReadUint(1))) : Fail();
+      case 0xcd: return Has(2) ? Napi::Number::New(env_, static_cast<double>(ReadUint(2))) : Fail();
+      case 0xce: return Has(4) ? Napi::Number::New(env_, static_cast<double>(ReadUint(4))) : Fail();
+      case 0xcf: return Has(8) ? Napi::Number::New(env_, static_cast<double>(ReadUint(8))) : Fail();
+      case 0xd0: return Has(1) ? Napi::Number::New(env_, static_cast<int8_t>(ReadUint(1))) : Fail();
+      case 0xd1: return Has(2) ? Napi::Number::New(env_, static_cast<int16_t>(ReadUint(2))) : Fail();
+      case 0xd2: return Has(4) ? Napi::Number::New(env_, static_cast<int32_t>(ReadUint(4))) : Fail();
+      case 0xd3: return Has(8) ? Napi::Number::New(env_, static_cast<double>(static_cast<int64_t>(ReadUint(8)))) : Fail();
+      case 0xd4: return Ext(1, depth);
+      case 0xd5: return Ext(2, depth);
+      case 0xd6: return Ext(4, depth);
+      case 0xd7: return Ext(8, depth);
+      case 0xd8: return Ext(16, depth);
+      case 0xd9: return Has(1) ? String(ReadUint(1)) : Fail();
+      case 0xda: return Has(2) ? String(ReadUint(2)) : Fail();
+      case 0xdb: return Has(4) ? String(ReadUint(4)) : Fail();
+      case 0xdc: return Has(2) ? Array(ReadUint(2), depth) : Fail();
+      case 0xdd: return Has(4) ? Array(ReadUint(4), depth) : Fail();
+      case 0xde: return Has(2) ? Map(ReadUint(2), depth) : Fail();
+      case 0xdf: return Has(4) ? Map(ReadUint(4), depth) : Fail();
+      default: return Fail();
+    }
+  }
+
+  bool AtEnd() const { return offset_ == length_; }
+
+ private:
+  bool Has(size_t bytes) const {
+    return length_ - offset_ >= bytes;
+  }
+
+  uint64_t ReadUint(int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; i++) {
+      value = (value << 8) | data_[offset_++];
+    }
+    return value;
+  }
+
+  Napi::Value Fail() {
+    if (!env_.IsExceptionPending()) {
+      Napi::TypeError::New(env_, "Malformed MessagePack value").ThrowAsJavaScriptException();
+    }
+    return Napi::Value();
+  }
+
+  Napi::Value String(size_t length) {
+    if (!Has(length)) return Fail();
+    Napi::Value value = Napi::String::New(env_, reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return value;
+  }
+
+  Napi::Value Bin(size_t length) {
+    if (!Has(length)) return Fail();
+    Napi::Value value = Napi::Buffer<char>::Copy(env_, reinterpret_cast<const char*>(data_ + offset_), length);
+    offset_ += length;
+    return value;
+  }
+
+  Napi::Value Array(size_t length, int depth) {
+    // Every element takes at least one byte
+    if (!Has(length)) return Fail();
+    Napi::Array array = Napi::Array::New(env_, length);
+    for (size_t i = 0; i < length; i++) {
+      Napi::Value element = Decode(depth + 1);
+      if (element.IsEmpty()) return element;
+      array.Set(static_cast<uint32_t>(i), element);
+    }
+    return array;
+  }
+
+  Napi::Value Map(size_t length, int depth) {
+    if (!Has(length)) return Fail();
+    Napi::Object object = Napi::Object::New(env_);
+    for (size_t i = 0; i < length; i++) {
+      Napi::Value key = Decode(depth + 1);
+      if (key.IsEmpty()) return key;
+      Napi::Value value = Decode(depth + 1);
+      if (value.IsEmpty()) return value;
+      object.Set(key, value);
+    }
+    return object;
+  }
+
+  Napi::Value Ext(size_t length, int depth) {
+    if (!Has(1 + length)) return Fail();
+    int8_t type = static_cast<int8_t>(data_[offset_++]);
+    const unsigned char* payload = data_ + offset_;
+    size_t end = offset_ + length;
+
+    Napi::Value result;
+    if (type == EXT_TIMESTAMP) {
+      result = Timestamp(length);
+    } else if (type == EXT_BIGINT && length >= 1) {
+      size_t size = length - 1;
+      std::vector<uint64_t> words((size + 7) / 8 > 0 ? (size + 7) / 8 : 1, 0);
+      for (size_t i = 0; i < size; i++) {
+        size_t fromEnd = size - 1 - i;
+        words[fromEnd / 8] |= static_cast<uint64_t>(payload[1 + i]) << ((fromEnd % 8) * 8);
+      }
+      result = Napi::BigInt::New(env_, payload[0] ? 1 : 0, words.size(), words.data());
+    } else if (type == EXT_MAP) {
+      Decoder entries(env_, payload, length, structures_);
+      Napi::Value array = entries.Decode(depth + 1);
+      if (array.IsEmpty()) return array;
+      result = env_.Global().Get("Map").As<Napi::Function>().New({array});
+    } else if (type == EXT_TYPED_ARRAY && length >= 1) {
+      result = TypedArray(payload[0], payload + 1, length - 1);
+    } else if (type == EXT_RECORD) {
+      Decoder fields(env_, payload, length, structures_);
+      result = fields.Record(depth);
+      if (!result.IsEmpty() && !fields.AtEnd()) {
+        return Fail();
+      }
+    } else {
+      return Fail();
+    }
+
+    if (result.IsEmpty() || env_.IsExceptionPending()) return Fail();
+    offset_ = end;
+    return result;
+  }
+
+  Napi::Value Record(int depth) {
+    if (!structures_) {
+      Napi::TypeError::New(env_, "Value holds records; read it through its database").ThrowAsJavaScriptException();
+      return Napi::Value();
+    }
+
+    Napi::Value id = Decode(depth + 1);
+    if (id.IsEmpty() || !id.IsNumber()) {
+      return Napi::Value();
+    }
+    const std::vector<Napi::Reference<Napi::String>>* keys =
+        structures_->KeysFor(env_, id.As<Napi::Number>().Uint32Value());
+    if (!keys) {
+      return Napi::Value();
+    }
+
+    // Setting the same keys in the same order gives every record of a
+    // structure the same hidden class
+    Napi::Object object = Napi::Object::New(env_);
+    for (const Napi::Reference<Napi::String>& key : *keys) {
+      Napi::Value value = Decode(depth + 1);
+      if (value.IsEmpty()) {
+        return value;
+      }
+      object.Set(key.Value(), value);
+    }
+    return object;
+  }
+
+  Napi::Value Timestamp(size_t length) {
+    uint64_t seconds;
+    uint32_t nanoseconds = 0;
+    if (length == 4) {
+      seconds = ReadUint(4);
+    } else if (length == 8) {
+      uint64_t packed = ReadUint(8);
+      nanoseconds = static_cast<uint32_t>(packed >> 34);
+      seconds = packed & 0x3ffffffffULL;
+    } else if (length == 12) {
+      nanoseconds = static_cast<uint32_t>(ReadUint(4));
+      seconds = ReadUint(8);
+    } else {
+      return Napi::Value();
+    }
+    double ms = static_cast<double>(static_cast<int64_t>(seconds)) * 1000 + nanoseconds / 1000000.0;
+    return Napi::Date::New(env_, ms);
+  }
+
+  Napi::Value TypedArray(uint8_t type, const unsigned char* bytes, size_t length) {
+    static const size_t kElementSize[] = {1, 1, 1, 2, 2, 4, 4, 4, 8, 8, 8};
+    if (type > napi_biguint64_array || length % kElementSize[type] != 0) {
+      return Napi::Value();
+    }
+    Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env_, length);
+    if (length > 0) {
+      std::memcpy(buffer.Data(), bytes, length);
+    }
+    // Napi::TypedArrayOf<T>::New() only accepts the type matching T, so the
+    // array is created through the C API
+    napi_value array;
+    napi_status status = napi_create_typedarray(env_, static_cast<napi_typedarray_type>(type),
+                                                length / kElementSize[type], buffer, 0, &array);
+    if (status != napi_ok) {
+      Napi::Error::New(env_, "Failed to create typed array").ThrowAsJavaScriptException();
+      return Napi::Value();
+    }
+    return Napi::TypedArray(env_, array);
+  }
+
+  Napi::Env env_;
+  const unsigned char* data_;
+  size_t length_;
+  Structures* structures_;
+  size_t offset_ = 0;
+};
+
+bool Encode(Napi::Env env, const Napi::Value& value, std::string& out, Structures* structures) {
+  Encoder encoder(env, out, structures);
+  return encoder.Encode(value, 0);
+}
+
+Napi::Value Decode(Napi::Env env, const unsigned char* data, size_t length, Structures* structures) {
+  Decoder decoder(env, data, length, structures);
+  Napi::Value value = decoder.Decode(0);
+  if (!value.IsEmpty() && !decoder.AtEnd()) {
+    Napi::TypeError::New(env, "Malformed MessagePack value").ThrowAsJavaScriptException();
+    return Napi::Value();
+  }
+  return value;
+}
+
+static Napi::Value EncodeValue(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  static thread_local std::string scratch;
+  scratch.clear();
+  if (!Encode(env, info.Length() > 0 ? info[0] : env.Undefined(), scratch)) {
+    return env.Null();
+  }
+  return Napi::Buffer<char>::Copy(env, scratch.data(), scratch.size());
+}
+
+static Napi::Value DecodeValue(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() < 1 || !info[0].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected a buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<unsigned char> buffer = info[0].As<Napi::Buffer<unsigned char>>();
+  Napi::Value value = Decode(env, buffer.Data(), buffer.Length());
+  return value.IsEmpty() ? env.Null() : value;
+}
+
+void Init(Napi::Env env, Napi::Object exports) {
+  exports.Set("encodeValue", Napi::Function::New(env, EncodeValue, "encodeValue"));
+  exports.Set("decodeValue", Napi::Function::New(env, DecodeValue, "decodeValue"));
+}
+
+}  // namespace Msgpack
\ No newline at end of file
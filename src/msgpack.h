@@ -0,0 +1,53 @@
+#ifndef MDBX_MSGPACK_H
+#define MDBX_MSGPACK_H
+
+#include <napi.h>
+#include <string>
+#include <vector>
+
+// MessagePack value codec. Plain JS values map onto the standard types;
+// the rest use extension types:
+//
+//   -1  Date         the standard MessagePack timestamp (96-bit form)
+//    1  BigInt       sign byte then big-endian magnitude
+//    2  Map          the encoded array of its [key, value] entries
+//    3  TypedArray   napi_typedarray_type byte then the raw element bytes
+//    4  Record       structure id then the values of its fields, in order
+//
+// Buffers are stored as bin. Object properties holding undefined, functions
+// or symbols are skipped, and such values elsewhere become nil, as in JSON.
+namespace Msgpack {
+
+// Source of record structures: shared field-name lists that let a plain
+// object be stored as a structure id followed by its values.
+class Structures {
+ public:
+  virtual ~Structures() {}
+
+  // Finds the id of the structure with these fields, defining it if possible.
+  // Returns false to encode the object as a plain map instead, with an
+  // exception pending if something failed.
+  virtual bool IdFor(Napi::Env env, const std::vector<std::string>& fields, uint32_t& id) = 0;
+
+  // Field-name keys of structure `id`, or null with an exception pending
+  virtual const std::vector<Napi::Reference<Napi::String>>* KeysFor(Napi::Env env, uint32_t id) = 0;
+};
+
+// Appends the encoding of `value` to `out`, writing plain objects as records
+// when `structures` is given. Throws and returns false for values that
+// cannot be encoded.
+bool Encode(Napi::Env env, const Napi::Value& value, std::string& out,
+            Structures* structures = nullptr);
+
+// Decodes the single value making up `data`, reading strings and binary data
+// straight from it. Throws and returns an empty value if it is malformed, or
+// holds records and no `structures` are given.
+Napi::Value Decode(Napi::Env env, const unsigned char* data, size_t length,
+                   Structures* structures = nullptr);
+
+// Exports encodeValue() and decodeValue()
+void Init(Napi::Env env, Napi::Object exports);
+
+}  // namespace Msgpack
+
+#endif // MDBX_MSGPACK_H
\ No newline at end of file
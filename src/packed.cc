@@ -0,0 +1,53 @@
+#include "packed.h"
+#include <cstring>
+
+static uint32_t ReadLength(const char* p) {
+  const unsigned char* b = reinterpret_cast<const unsigned char*>(p);
+  return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+         (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+}
+
+static void WriteLength(char* p, uint32_t length) {
+  unsigned char* b = reinterpret_cast<unsigned char*>(p);
+  b[0] = static_cast<unsigned char>(length);
+  b[1] = static_cast<unsigned char>(length >> 8);
+  b[2] = static_cast<unsigned char>(length >> 16);
+  b[3] = static_cast<unsigned char>(length >> 24);
+}
+
+bool UnpackRecords(const char* data, size_t length, std::vector<MDBX_val>& records) {
+  size_t offset = 0;
+  while (offset < length) {
+    if (length - offset < 4) {
+      return false;
+    }
+    uint32_t recordLength = ReadLength(data + offset);
+    offset += 4;
+    if (recordLength == PACKED_MISSING || recordLength > length - offset) {
+      return false;
+    }
+
+    MDBX_val val;
+    val.iov_base = const_cast<char*>(data + offset);
+    val.iov_len = recordLength;
+    records.push_back(val);
+    offset += recordLength;
+  }
+  return true;
+}
+
+size_t PackedSize(const MDBX_val* val) {
+  return 4 + (val ? val->iov_len : 0);
+}
+
+char* PackRecord(char* out, const MDBX_val* val) {
+  if (!val) {
+    WriteLength(out, PACKED_MISSING);
+    return out + 4;
+  }
+  WriteLength(out, static_cast<uint32_t>(val->iov_len));
+  if (val->iov_len > 0) {
+    std::memcpy(out + 4, val->iov_base, val->iov_len);
+  }
+  return out + 4 + val->iov_len;
+}
\ No newline at end of file
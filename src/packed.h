@@ -0,0 +1,24 @@
+#ifndef MDBX_PACKED_H
+#define MDBX_PACKED_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mdbx_wrapper.h"
+
+// Packed record format used by the batch APIs: each record is a little-endian
+// uint32 byte length followed by that many bytes. In results, a length of
+// PACKED_MISSING stands for a record that was not found and has no bytes.
+static const uint32_t PACKED_MISSING = 0xFFFFFFFF;
+
+// Splits `data` into records pointing into it. Returns false if the buffer is
+// truncated or contains a missing record.
+bool UnpackRecords(const char* data, size_t length, std::vector<MDBX_val>& records);
+
+// Bytes needed to pack `val`, or a missing record when it is null
+size_t PackedSize(const MDBX_val* val);
+
+// Writes one record at `out` and returns the position just past it
+char* PackRecord(char* out, const MDBX_val* val);
+
+#endif // MDBX_PACKED_H
\ No newline at end of file
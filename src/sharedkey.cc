@@ -0,0 +1,66 @@
+#include "sharedkey.h"
+#include <string>
+#include "utf8.h"
+
+namespace SharedKey {
+
+static thread_local Napi::Reference<Napi::ArrayBuffer> area;
+static thread_local char* areaData = nullptr;
+static thread_local std::string keyScratch;
+static thread_local std::string valueScratch;
+
+bool Resolve(const Napi::Value& arg, MDBX_val& key) {
+  if (arg.IsBuffer()) {
+    Napi::Buffer<char> buffer = arg.As<Napi::Buffer<char>>();
+    key.iov_base = buffer.Data();
+    key.iov_len = buffer.Length();
+    return true;
+  }
+  if (arg.IsString()) {
+    Utf8::Encode(arg, keyScratch);
+    key.iov_base = &keyScratch[0];
+    key.iov_len = keyScratch.size();
+    return true;
+  }
+  if (!arg.IsNumber() || !areaData) {
+    return false;
+  }
+
+  double length = arg.As<Napi::Number>().DoubleValue();
+  if (!(length >= 0 && length <= kSize) || length != static_cast<double>(static_cast<size_t>(length))) {
+    return false;
+  }
+  // A transferred area no longer owns its memory
+  if (area.Value().IsDetached()) {
+    return false;
+  }
+  key.iov_base = areaData;
+  key.iov_len = static_cast<size_t>(length);
+  return true;
+}
+
+bool ResolveValue(const Napi::Value& arg, MDBX_val& value) {
+  if (arg.IsBuffer()) {
+    Napi::Buffer<char> buffer = arg.As<Napi::Buffer<char>>();
+    value.iov_base = buffer.Data();
+    value.iov_len = buffer.Length();
+    return true;
+  }
+  if (arg.IsString()) {
+    Utf8::Encode(arg, valueScratch);
+    value.iov_base = &valueScratch[0];
+    value.iov_len = valueScratch.size();
+    return true;
+  }
+  return false;
+}
+
+void Init(Napi::Env env, Napi::Object exports) {
+  Napi::ArrayBuffer buffer = Napi::ArrayBuffer::New(env, kSize);
+  areaData = static_cast<char*>(buffer.Data());
+  area = Napi::Persistent(buffer);
+  area.SuppressDestruct();
+  exports.Set("keyBuffer", buffer);
+}
+
+}  // namespace SharedKey
\ No newline at end of file
@@ -0,0 +1,31 @@
+#ifndef MDBX_SHAREDKEY_H
+#define MDBX_SHAREDKEY_H
+
+#include <napi.h>
+#include "mdbx_wrapper.h"
+
+// A preallocated scratch area, exported as `keyBuffer`, that JS writes keys
+// into before calling get/put/del with just the key's length. Hot point
+// reads then allocate no Buffer per key. The area belongs to the addon
+// instance of the current thread and is only read synchronously, before
+// any JS can run again.
+namespace SharedKey {
+
+static const size_t kSize = 64 * 1024;
+
+// Reads a key argument: a Buffer, a string, which is UTF-8 encoded natively
+// into scratch memory, or the length of a key written at the start of the
+// shared area. Returns false for anything else. The key stays valid until
+// the next call.
+bool Resolve(const Napi::Value& arg, MDBX_val& key);
+
+// Reads a value argument: a Buffer or a string, encoded like string keys
+// into scratch memory of its own. Returns false for anything else.
+bool ResolveValue(const Napi::Value& arg, MDBX_val& value);
+
+// Exports keyBuffer
+void Init(Napi::Env env, Napi::Object exports);
+
+}  // namespace SharedKey
+
+#endif // MDBX_SHAREDKEY_H
\ No newline at end of file
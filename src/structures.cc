@@ -0,0 +1,220 @@
+#include "structures.h"
+#include "packed.h"
+#include <cstring>
+
+const char* const MdbxStructures::STORE_NAME = "__mdbxjs_structures";
+
+MdbxStructures::MdbxStructures(MDBX_env* env, MDBX_dbi store, const std::string& owner)
+  : env_(env), store_(store), owner_(owner) {}
+
+std::string MdbxStructures::StoreKey(uint32_t id) const {
+  std::string key = owner_;
+  key.push_back('\0');
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    key.push_back(static_cast<char>(id >> shift));
+  }
+  return key;
+}
+
+bool MdbxStructures::IdOf(const MDBX_val& key, uint32_t& id) const {
+  const unsigned char* bytes = static_cast<const unsigned char*>(key.iov_base);
+  if (key.iov_len != owner_.size() + 5 || std::memcmp(bytes, owner_.data(), owner_.size()) != 0 ||
+      bytes[owner_.size()] != 0) {
+    return false;
+  }
+  const unsigned char* last = bytes + owner_.size() + 1;
+  id = (static_cast<uint32_t>(last[0]) << 24) | (static_cast<uint32_t>(last[1]) << 16) |
+       (static_cast<uint32_t>(last[2]) << 8) | last[3];
+  return true;
+}
+
+std::string MdbxStructures::Signature(const std::vector<std::string>& fields) {
+  std::string signature;
+  for (const std::string& field : fields) {
+    signature.append(field);
+    signature.push_back('\0');
+  }
+  return signature;
+}
+
+int MdbxStructures::Load(MDBX_txn* txn, uint32_t id) {
+  std::string storeKey = StoreKey(id);
+  MDBX_val key, data;
+  key.iov_base = &storeKey[0];
+  key.iov_len = storeKey.size();
+
+  int rc = mdbx_get(txn, store_, &key, &data);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+  return Cache(id, data);
+}
+
+int MdbxStructures::Cache(uint32_t id, const MDBX_val& data) {
+  std::vector<MDBX_val> records;
+  if (!UnpackRecords(static_cast<const char*>(data.iov_base), data.iov_len, records)) {
+    return MDBX_CORRUPTED;
+  }
+
+  Structure& structure = defs_[id];
+  structure.fields.clear();
+  structure.keys.clear();
+  for (const MDBX_val& record : records) {
+    structure.fields.emplace_back(static_cast<const char*>(record.iov_base), record.iov_len);
+  }
+  ids_.emplace(Signature(structure.fields), id);
+  return MDBX_SUCCESS;
+}
+
+int MdbxStructures::Open(MDBX_txn* txn) {
+  MDBX_cursor* cursor;
+  int rc = mdbx_cursor_open(txn, store_, &cursor);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  std::string prefix = owner_;
+  prefix.push_back('\0');
+  MDBX_val key, data;
+  key.iov_base = &prefix[0];
+  key.iov_len = prefix.size();
+  uint32_t id;
+  for (rc = mdbx_cursor_get(cursor, &key, &data, MDBX_SET_RANGE);
+       rc == MDBX_SUCCESS && IdOf(key, id);
+       rc = mdbx_cursor_get(cursor, &key, &data, MDBX_NEXT)) {
+    rc = Cache(id, data);
+    if (rc != MDBX_SUCCESS) {
+      break;
+    }
+  }
+  mdbx_cursor_close(cursor);
+  return rc == MDBX_NOTFOUND ? MDBX_SUCCESS : rc;
+}
+
+int MdbxStructures::Define(MDBX_txn* txn, const std::vector<std::string>& fields, uint32_t& id) {
+  // Ids are allocated from the store itself, which this write transaction
+  // sees exactly, so definitions made elsewhere are never reused
+  MDBX_cursor* cursor;
+  int rc = mdbx_cursor_open(txn, store_, &cursor);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  std::string after = owner_;
+  after.push_back('\1');
+  MDBX_val key, data;
+  key.iov_base = &after[0];
+  key.iov_len = after.size();
+  rc = mdbx_cursor_get(cursor, &key, &data, MDBX_SET_RANGE);
+  rc = mdbx_cursor_get(cursor, &key, &data, rc == MDBX_SUCCESS ? MDBX_PREV : MDBX_LAST);
+  mdbx_cursor_close(cursor);
+
+  id = 0;
+  uint32_t last;
+  if (rc == MDBX_SUCCESS) {
+    if (IdOf(key, last)) {
+      id = last + 1;
+    }
+  } else if (rc != MDBX_NOTFOUND) {
+    return rc;
+  }
+
+  std::vector<MDBX_val> records(fields.size());
+  size_t total = 0;
+  for (size_t i = 0; i < fields.size(); i++) {
+    records[i].iov_base = const_cast<char*>(fields[i].data());
+    records[i].iov_len = fields[i].size();
+    total += PackedSize(&records[i]);
+  }
+  std::string packed(total, '\0');
+  char* out = &packed[0];
+  for (const MDBX_val& record : records) {
+    out = PackRecord(out, &record);
+  }
+
+  std::string storeKey = StoreKey(id);
+  key.iov_base = &storeKey[0];
+  key.iov_len = storeKey.size();
+  data.iov_base = &packed[0];
+  data.iov_len = packed.size();
+  rc = mdbx_put(txn, store_, &key, &data, MDBX_NOOVERWRITE);
+  if (rc != MDBX_SUCCESS) {
+    return rc;
+  }
+
+  Structure& structure = defs_[id];
+  structure.fields = fields;
+  structure.keys.clear();
+  structure.pendingIn = txn;
+  ids_[Signature(fields)] = id;
+  return MDBX_SUCCESS;
+}
+
+void MdbxStructures::EndTxn(MDBX_txn* txn, MDBX_txn* parent, bool committed) {
+  for (auto it = defs_.begin(); it != defs_.end();) {
+    if (it->second.pendingIn != txn) {
+      ++it;
+    } else if (committed) {
+      it->second.pendingIn = parent;
+      ++it;
+    } else {
+      auto id = ids_.find(Signature(it->second.fields));
+      if (id != ids_.end() && id->second == it->first) {
+        ids_.erase(id);
+      }
+      it = defs_.erase(it);
+    }
+  }
+}
+
+bool MdbxStructures::Session::IdFor(Napi::Env env, const std::vector<std::string>& fields, uint32_t& id) {
+  auto found = structures_.ids_.find(Signature(fields));
+  if (found != structures_.ids_.end()) {
+    id = found->second;
+    return true;
+  }
+  if (!writable_) {
+    return false;
+  }
+
+  int rc = structures_.Define(txn_, fields, id);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return false;
+  }
+  defined_ = true;
+  return true;
+}
+
+const std::vector<Napi::Reference<Napi::String>>* MdbxStructures::Session::KeysFor(Napi::Env env, uint32_t id) {
+  auto found = structures_.defs_.find(id);
+  if (found == structures_.defs_.end()) {
+    int rc;
+    if (txn_) {
+      rc = structures_.Load(txn_, id);
+    } else {
+      MDBX_txn* txn;
+      rc = mdbx_txn_begin(structures_.env_, nullptr, MDBX_TXN_RDONLY, &txn);
+      if (rc == MDBX_SUCCESS) {
+        rc = structures_.Load(txn, id);
+        mdbx_txn_abort(txn);
+      }
+    }
+
+    if (rc != MDBX_SUCCESS) {
+      Napi::Error::New(env, rc == MDBX_NOTFOUND ? "Unknown record structure" : mdbx_strerror(rc)).ThrowAsJavaScriptException();
+      return nullptr;
+    }
+    found = structures_.defs_.find(id);
+  }
+
+  // Keys are created once per structure and reused by every record
+  Structure& structure = found->second;
+  if (structure.keys.size() != structure.fields.size()) {
+    structure.keys.clear();
+    for (const std::string& field : structure.fields) {
+      structure.keys.push_back(Napi::Persistent(Napi::String::New(env, field)));
+    }
+  }
+  return &structure.keys;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef MDBX_STRUCTURES_H
+#define MDBX_STRUCTURES_H
+
+#include <napi.h>
+#include <map>
+#include <string>
+#include <vector>
+#include "mdbx_wrapper.h"
+#include "msgpack.h"
+
+// Record structures of one database: the field-name lists its MessagePack
+// records refer to by id instead of repeating the names in every value. The
+// definitions are kept in the reserved STORE_NAME table, keyed by the owning
+// database's name and the big-endian id, and cached here. Structures defined
+// by a write transaction only become permanent in the cache once it commits.
+class MdbxStructures {
+ public:
+  static const char* const STORE_NAME;
+
+  MdbxStructures(MDBX_env* env, MDBX_dbi store, const std::string& owner);
+
+  // Loads the database's committed structures, so handles opened later reuse
+  // them instead of defining the same field lists again
+  int Open(MDBX_txn* txn);
+
+  // Binds the cache to a transaction for encoding or decoding. New structures
+  // can only be defined through a write transaction; without any transaction
+  // unknown ids are loaded through a short read transaction.
+  class Session : public Msgpack::Structures {
+   public:
+    Session(MdbxStructures& structures, MDBX_txn* txn, bool writable)
+      : structures_(structures), txn_(txn), writable_(writable) {}
+
+    bool IdFor(Napi::Env env, const std::vector<std::string>& fields, uint32_t& id) override;
+    const std::vector<Napi::Reference<Napi::String>>* KeysFor(Napi::Env env, uint32_t id) override;
+
+    // Whether a structure was defined in the transaction
+    bool Defined() const { return defined_; }
+
+   private:
+    MdbxStructures& structures_;
+    MDBX_txn* txn_;
+    bool writable_;
+    bool defined_ = false;
+  };
+
+  // Settles the structures defined in `txn`. On commit they pass to `parent`,
+  // or become permanent when it is null; on abort they are forgotten.
+  void EndTxn(MDBX_txn* txn, MDBX_txn* parent, bool committed);
+
+ private:
+  struct Structure {
+    std::vector<std::string> fields;
+    std::vector<Napi::Reference<Napi::String>> keys;
+    MDBX_txn* pendingIn = nullptr;
+  };
+
+  std::string StoreKey(uint32_t id) const;
+  // The id stored in `key`, false if it isn't a key of this database
+  bool IdOf(const MDBX_val& key, uint32_t& id) const;
+  // Caches the definition stored under `id`
+  int Cache(uint32_t id, const MDBX_val& data);
+  static std::string Signature(const std::vector<std::string>& fields);
+  int Load(MDBX_txn* txn, uint32_t id);
+  int Define(MDBX_txn* txn, const std::vector<std::string>& fields, uint32_t& id);
+
+  MDBX_env* env_;
+  MDBX_dbi store_;
+  std::string owner_;
+  std::map<uint32_t, Structure> defs_;
+  std::map<std::string, uint32_t> ids_;
+};
+
+#endif // MDBX_STRUCTURES_H
\ No newline at end of file
@@ -1,7 +1,17 @@
 #include "txn.h"
 #include "dbi.h"
+#include "handle.h"
+#include "workers.h"
+#include "packed.h"
+#include "msgpack.h"
+#include "structures.h"
+#include "sharedkey.h"
+#include "core.h"
+#include <algorithm>
+#include <cstring>
+#include <numeric>
 
-Napi::FunctionReference MdbxTxn::constructor;
+thread_local Napi::FunctionReference MdbxTxn::constructor;
 
 Napi::Object MdbxTxn::Init(Napi::Env env, Napi::Object exports) {
   Napi::HandleScope scope(env);
@@ -9,11 +19,20 @@ Napi::Object MdbxTxn::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "Transaction", {
     InstanceMethod("abort", &MdbxTxn::Abort),
     InstanceMethod("commit", &MdbxTxn::Commit),
+    InstanceMethod("commitAsync", &MdbxTxn::CommitAsync),
     InstanceMethod("reset", &MdbxTxn::Reset),
     InstanceMethod("renew", &MdbxTxn::Renew),
     InstanceMethod("get", &MdbxTxn::Get),
+    InstanceMethod("getString", &MdbxTxn::GetString),
+    InstanceMethod("getInto", &MdbxTxn::GetInto),
+    InstanceMethod("getMany", &MdbxTxn::GetMany),
+    InstanceMethod("getDecoded", &MdbxTxn::GetDecoded),
+    InstanceMethod("getAsync", &MdbxTxn::GetAsync),
     InstanceMethod("put", &MdbxTxn::Put),
-    InstanceMethod("del", &MdbxTxn::Del)
+    InstanceMethod("putMany", &MdbxTxn::PutMany),
+    InstanceMethod("putEncoded", &MdbxTxn::PutEncoded),
+    InstanceMethod("del", &MdbxTxn::Del),
+    InstanceMethod("bind", &MdbxTxn::Bind)
   });
 
   constructor = Napi::Persistent(func);
@@ -53,6 +72,21 @@ MdbxTxn::MdbxTxn(const Napi::CallbackInfo& info)
         flags |= MDBX_RDONLY;
       }
     }
+
+    if (options.Has("zeroCopy")) {
+      zeroCopy_ = options.Get("zeroCopy").ToBoolean();
+    }
+
+    // Per-transaction durability flags (TxnFlags)
+    if (options.Has("flags") && options.Get("flags").IsNumber()) {
+      flags |= options.Get("flags").ToNumber().Uint32Value();
+    }
+
+    // A write transaction meant for commitAsync() skips the fsync of its
+    // commit; commitAsync() then runs it on the threadpool
+    if (options.Has("asyncCommit") && options.Get("asyncCommit").ToBoolean() && !(flags & MDBX_RDONLY)) {
+      flags |= MDBX_TXN_NOSYNC;
+    }
     
     // Check for parent transaction
     if (options.Has("parent") && options.Get("parent").IsObject()) {
@@ -62,11 +96,27 @@ MdbxTxn::MdbxTxn(const Napi::CallbackInfo& info)
         Napi::Error::New(env, "Invalid parent transaction").ThrowAsJavaScriptException();
         return;
       }
+      parent_ = parent;
+      parentRef_ = Napi::Persistent(parentObj);
     }
   }
 
   // Store whether this is a read-only transaction
   isReadOnly_ = (flags & MDBX_RDONLY) != 0;
+  flags_ = flags;
+  env_ = mdbxEnv;
+  envRef_ = Napi::Persistent(info[0].As<Napi::Object>());
+  metrics_ = &mdbxEnv->shared_->metrics;
+
+  // Plain read-only transactions are renewed from the environment's pool
+  txn_ = nullptr;
+  if (flags == MDBX_RDONLY) {
+    txn_ = mdbxEnv->AcquireReadTxn();
+    if (txn_) {
+      metrics_->Add(MdbxMetrics::TXNS_BEGUN);
+      return;
+    }
+  }
 
   // Begin transaction
   int rc = mdbx_txn_begin(mdbxEnv->env_, parent ? parent->txn_ : nullptr, static_cast<MDBX_txn_flags_t>(flags), &txn_);
@@ -74,11 +124,141 @@ MdbxTxn::MdbxTxn(const Napi::CallbackInfo& info)
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
+  metrics_->Add(MdbxMetrics::TXNS_BEGUN);
+}
+
+void MdbxTxn::DetachMapped() {
+  for (Napi::Reference<Napi::ArrayBuffer>& ref : mapped_) {
+    if (!ref.IsEmpty()) {
+      Napi::ArrayBuffer buffer = ref.Value();
+      if (!buffer.IsEmpty() && !buffer.IsDetached()) {
+        buffer.Detach();
+      }
+    }
+  }
+  mapped_.clear();
+  mappedCompactAt_ = 64;
+}
+
+Napi::Buffer<char> MdbxTxn::WrapValue(Napi::Env env, const MDBX_val& val) {
+  char* data = static_cast<char*>(val.iov_base);
+
+  // mdbx_is_dirty() also rejects pointers outside the map, such as a key
+  // that MDBX_SET hands back unchanged from the caller's own buffer
+  if (!zeroCopy_ || val.iov_len == 0 || mdbx_is_dirty(txn_, data) != MDBX_RESULT_FALSE) {
+    return Napi::Buffer<char>::Copy(env, data, val.iov_len);
+  }
+
+  Napi::Buffer<char> buffer = Napi::Buffer<char>::New(env, data, val.iov_len);
+  if (env.IsExceptionPending()) {
+    // Runtimes with a V8 sandbox refuse external buffers
+    env.GetAndClearPendingException();
+    zeroCopy_ = false;
+    return Napi::Buffer<char>::Copy(env, data, val.iov_len);
+  }
+
+  // Drop references to buffers that have been collected before growing
+  if (mapped_.size() >= mappedCompactAt_) {
+    std::vector<Napi::Reference<Napi::ArrayBuffer>> live;
+    for (Napi::Reference<Napi::ArrayBuffer>& ref : mapped_) {
+      if (!ref.Value().IsEmpty()) {
+        live.push_back(std::move(ref));
+      }
+    }
+    mapped_.swap(live);
+    mappedCompactAt_ = mapped_.size() * 2 > 64 ? mapped_.size() * 2 : 64;
+  }
+  mapped_.push_back(Napi::Weak(buffer.ArrayBuffer()));
+
+  return buffer;
+}
+
+bool MdbxTxn::ResolveTarget(const Napi::Value& target, const Napi::Value& offset,
+                            char*& out, size_t& room) {
+  size_t length;
+  if (target.IsBuffer()) {
+    Napi::Buffer<char> buffer = target.As<Napi::Buffer<char>>();
+    out = buffer.Data();
+    length = buffer.Length();
+  } else if (target.IsArrayBuffer()) {
+    Napi::ArrayBuffer buffer = target.As<Napi::ArrayBuffer>();
+    if (buffer.IsDetached()) {
+      return false;
+    }
+    out = static_cast<char*>(buffer.Data());
+    length = buffer.ByteLength();
+  } else {
+    return false;
+  }
+
+  size_t start = 0;
+  if (offset.IsNumber()) {
+    int64_t value = offset.As<Napi::Number>().Int64Value();
+    if (value < 0 || static_cast<uint64_t>(value) > length) {
+      return false;
+    }
+    start = static_cast<size_t>(value);
+  }
+  out += start;
+  room = length - start;
+  return true;
+}
+
+Napi::Value MdbxTxn::CopyInto(Napi::Env env, const MDBX_val& val, char* out, size_t room) {
+  double length = static_cast<double>(val.iov_len);
+  if (val.iov_len > room) {
+    return Napi::Number::New(env, -length);
+  }
+  if (val.iov_len > 0) {
+    std::memcpy(out, val.iov_base, val.iov_len);
+  }
+  return Napi::Number::New(env, length);
+}
+
+int MdbxTxn::Finish(bool commit, MDBX_commit_latency* latency) {
+  DetachMapped();
+
+  MDBX_txn* txn = txn_;
+  txn_ = nullptr;
+
+  // Committing a read-only transaction only releases its snapshot, the same
+  // as resetting it
+  if (isReadOnly_ && flags_ == MDBX_RDONLY && env_->ReleaseReadTxn(txn, isReset_)) {
+    metrics_->Add(commit ? MdbxMetrics::TXNS_COMMITTED : MdbxMetrics::TXNS_ABORTED);
+    return MDBX_SUCCESS;
+  }
+
+  if (commit) {
+    int rc = MdbxCommitStats::Commit(txn, latency);
+    metrics_->Add(rc == MDBX_SUCCESS ? MdbxMetrics::TXNS_COMMITTED : MdbxMetrics::TXNS_ABORTED);
+    EndStructures(txn, rc == MDBX_SUCCESS);
+    return rc;
+  }
+  metrics_->Add(MdbxMetrics::TXNS_ABORTED);
+  mdbx_txn_abort(txn);
+  EndStructures(txn, false);
+  return MDBX_SUCCESS;
+}
+
+void MdbxTxn::EndStructures(MDBX_txn* txn, bool committed) {
+  // Definitions committed by a nested transaction stay pending in its parent
+  MDBX_txn* parent = parent_ ? parent_->txn_ : nullptr;
+  for (std::shared_ptr<MdbxStructures>& structures : structures_) {
+    structures->EndTxn(txn, parent, committed);
+    if (committed && parent_ && parent_->txn_ &&
+        std::find(parent_->structures_.begin(), parent_->structures_.end(), structures) == parent_->structures_.end()) {
+      parent_->structures_.push_back(structures);
+    }
+  }
+  structures_.clear();
 }
 
 MdbxTxn::~MdbxTxn() {
+  DetachMapped();
   if (txn_) {
+    metrics_->Add(MdbxMetrics::TXNS_ABORTED);
     mdbx_txn_abort(txn_);
+    EndStructures(txn_, false);
     txn_ = nullptr;
   }
 }
@@ -87,28 +267,102 @@ void MdbxTxn::Abort(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
+  if (pendingAsync_ > 0) {
+    Napi::Error::New(env, "Transaction has pending async operations").ThrowAsJavaScriptException();
+    return;
+  }
+
   if (txn_) {
-    mdbx_txn_abort(txn_);
-    txn_ = nullptr;
+    Finish(false);
   }
 }
 
-void MdbxTxn::Commit(const Napi::CallbackInfo& info) {
+Napi::Value MdbxTxn::Commit(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
   if (!txn_) {
     Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
-    return;
+    return env.Null();
   }
 
-  int rc = mdbx_txn_commit(txn_);
-  txn_ = nullptr;
+  if (pendingAsync_ > 0) {
+    Napi::Error::New(env, "Transaction has pending async operations").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  bool isWrite = !isReadOnly_;
+  MDBX_commit_latency latency;
+  int rc = Finish(true, &latency);
   
   if (rc != MDBX_SUCCESS) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
-    return;
+    return env.Null();
+  }
+
+  if (!isWrite) {
+    return env.Undefined();
+  }
+
+  // Time spent in each phase of the commit, in microseconds
+  Napi::Object result = Napi::Object::New(env);
+  const uint32_t units[MdbxCommitStats::PHASES] = {
+    latency.preparation, latency.gc, latency.audit, latency.write,
+    latency.sync, latency.ending, latency.whole
+  };
+  for (int phase = 0; phase < MdbxCommitStats::PHASES; phase++) {
+    result.Set(MdbxCommitStats::kPhaseNames[phase], Napi::Number::New(env, MdbxCommitStats::Micros(units[phase])));
+  }
+  return result;
+}
+
+Napi::Value MdbxTxn::CommitAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (pendingAsync_ > 0) {
+    Napi::Error::New(env, "Transaction has pending async operations").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // A write transaction can only be committed by the thread that began it, so
+  // the commit itself happens here. Its durability can't be changed after
+  // begin, so only a transaction whose commit skips the fsync (begun with
+  // asyncCommit or MDBX_TXN_NOSYNC, or in a NOSYNC environment) gets it run on
+  // the threadpool. A durable one would fsync right here, blocking the event
+  // loop, so it is refused rather than quietly committed like commit().
+  unsigned envFlags = 0;
+  mdbx_env_get_flags(env_->env_, &envFlags);
+  bool deferSync = !isReadOnly_ && !parent_ &&
+                   ((flags_ & (MDBX_TXN_NOSYNC | MDBX_TXN_NOMETASYNC)) ||
+                    (envFlags & (MDBX_SAFE_NOSYNC | MDBX_NOMETASYNC | MDBX_UTTERLY_NOSYNC)));
+  if (!isReadOnly_ && !parent_ && !deferSync) {
+    Napi::Error::New(env, "commitAsync requires a transaction begun with asyncCommit: true; use commit() for a synchronous durable commit").ThrowAsJavaScriptException();
+    return env.Null();
   }
+
+  int rc = Finish(true);
+
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!deferSync) {
+    Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+    deferred.Resolve(env.Undefined());
+    return deferred.Promise();
+  }
+
+  MdbxSyncWorker* worker = new MdbxSyncWorker(env, &env_->pendingAsync_, {envRef_.Value()}, env_->env_);
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
 }
 
 void MdbxTxn::Reset(const Napi::CallbackInfo& info) {
@@ -120,12 +374,19 @@ void MdbxTxn::Reset(const Napi::CallbackInfo& info) {
     return;
   }
 
+  if (pendingAsync_ > 0) {
+    Napi::Error::New(env, "Transaction has pending async operations").ThrowAsJavaScriptException();
+    return;
+  }
+
   if (!isReadOnly_) {
     Napi::Error::New(env, "Only read-only transactions can be reset").ThrowAsJavaScriptException();
     return;
   }
   
+  DetachMapped();
   mdbx_txn_reset(txn_);
+  isReset_ = true;
 }
 
 void MdbxTxn::Renew(const Napi::CallbackInfo& info) {
@@ -137,6 +398,11 @@ void MdbxTxn::Renew(const Napi::CallbackInfo& info) {
     return;
   }
 
+  if (pendingAsync_ > 0) {
+    Napi::Error::New(env, "Transaction has pending async operations").ThrowAsJavaScriptException();
+    return;
+  }
+
   if (!isReadOnly_) {
     Napi::Error::New(env, "Only read-only transactions can be renewed").ThrowAsJavaScriptException();
     return;
@@ -147,13 +413,15 @@ void MdbxTxn::Renew(const Napi::CallbackInfo& info) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
+  isReset_ = false;
 }
 
 Napi::Value MdbxTxn::Get(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
-  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsBuffer()) {
+  MDBX_val key, data;
+  if (info.Length() < 2 || !info[0].IsObject() || !SharedKey::Resolve(info[1], key)) {
     Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
     return env.Null();
   }
@@ -169,13 +437,45 @@ Napi::Value MdbxTxn::Get(const Napi::CallbackInfo& info) {
     return env.Null();
   }
 
-  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
-  
+  std::string scratch;
+  MdbxMetrics::Timer timer(metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_, dbi->dbi_, dbi->compression_.get(), key, data, scratch);
+  metrics_->Read(rc, data.iov_len);
+  if (rc == MDBX_NOTFOUND) {
+    return env.Null();
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return WrapValue(env, data);
+}
+
+Napi::Value MdbxTxn::GetString(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
   MDBX_val key, data;
-  key.iov_base = keyBuffer.Data();
-  key.iov_len = keyBuffer.Length();
+  if (info.Length() < 2 || !info[0].IsObject() || !SharedKey::Resolve(info[1], key)) {
+    Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
 
-  int rc = mdbx_get(txn_, dbi->dbi_, &key, &data);
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string scratch;
+  MdbxMetrics::Timer timer(metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_, dbi->dbi_, dbi->compression_.get(), key, data, scratch);
+  metrics_->Read(rc, data.iov_len);
   if (rc == MDBX_NOTFOUND) {
     return env.Null();
   } else if (rc != MDBX_SUCCESS) {
@@ -183,17 +483,280 @@ Napi::Value MdbxTxn::Get(const Napi::CallbackInfo& info) {
     return env.Null();
   }
 
-  return Napi::Buffer<char>::Copy(env, 
-                                  static_cast<char*>(data.iov_base),
-                                  data.iov_len);
+  // Builds the string straight from the mapped bytes, without a Buffer
+  return Napi::String::New(env, static_cast<const char*>(data.iov_base), data.iov_len);
+}
+
+Napi::Value MdbxTxn::GetInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  MDBX_val key, data;
+  char* out;
+  size_t room;
+  if (info.Length() < 3 || !info[0].IsObject() ||
+      !ResolveTarget(info[2], info.Length() > 3 ? info[3] : env.Undefined(), out, room) ||
+      !SharedKey::Resolve(info[1], key)) {
+    Napi::TypeError::New(env, "Expected database, key, target buffer and offset within it").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::string scratch;
+  MdbxMetrics::Timer timer(metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_, dbi->dbi_, dbi->compression_.get(), key, data, scratch);
+  metrics_->Read(rc, data.iov_len);
+  if (rc == MDBX_NOTFOUND) {
+    return env.Null();
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return CopyInto(env, data, out, room);
+}
+
+Napi::Value MdbxTxn::GetDecoded(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  MDBX_val key, data;
+  if (info.Length() < 2 || !info[0].IsObject() || !SharedKey::Resolve(info[1], key)) {
+    Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  static thread_local std::string scratch;
+  MdbxMetrics::Timer timer(metrics_, MdbxMetrics::GET);
+  int rc = MdbxCore::Get(txn_, dbi->dbi_, dbi->compression_.get(), key, data, scratch);
+  metrics_->Read(rc, data.iov_len);
+  if (rc == MDBX_NOTFOUND) {
+    return env.Undefined();
+  } else if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Decodes straight from the mapped (or decompressed) value, without an
+  // intermediate Buffer
+  const unsigned char* bytes = static_cast<const unsigned char*>(data.iov_base);
+  Napi::Value value;
+  if (dbi->structures_) {
+    MdbxStructures::Session session(*dbi->structures_, txn_, false);
+    value = Msgpack::Decode(env, bytes, data.iov_len, &session);
+  } else {
+    value = Msgpack::Decode(env, bytes, data.iov_len);
+  }
+  return value.IsEmpty() ? env.Null() : value;
+}
+
+Napi::Value MdbxTxn::GetMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !(info[1].IsArray() || info[1].IsBuffer())) {
+    Napi::TypeError::New(env, "Expected database and an array of key buffers or a packed key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Keys point into the caller's buffers, which the arguments keep alive
+  std::vector<MDBX_val> keys;
+  bool packed = info[1].IsBuffer();
+  if (packed) {
+    Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+    if (!UnpackRecords(keyBuffer.Data(), keyBuffer.Length(), keys)) {
+      Napi::TypeError::New(env, "Malformed packed key buffer").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  } else {
+    Napi::Array keyArray = info[1].As<Napi::Array>();
+    keys.reserve(keyArray.Length());
+    for (uint32_t i = 0; i < keyArray.Length(); i++) {
+      Napi::Value item = keyArray.Get(i);
+      if (!item.IsBuffer()) {
+        Napi::TypeError::New(env, "Keys must be buffers").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      Napi::Buffer<char> keyBuffer = item.As<Napi::Buffer<char>>();
+      MDBX_val key;
+      key.iov_base = keyBuffer.Data();
+      key.iov_len = keyBuffer.Length();
+      keys.push_back(key);
+    }
+  }
+
+  // Look the keys up in database order so that one cursor walks the tree
+  // forwards, mostly staying on pages it has just visited
+  std::vector<size_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  MDBX_dbi dbiHandle = dbi->dbi_;
+  std::sort(order.begin(), order.end(), [this, dbiHandle, &keys](size_t a, size_t b) {
+    return mdbx_cmp(txn_, dbiHandle, &keys[a], &keys[b]) < 0;
+  });
+
+  MDBX_cursor* cursor;
+  int rc = mdbx_cursor_open(txn_, dbiHandle, &cursor);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  std::vector<MDBX_val> values(keys.size());
+  std::vector<bool> found(keys.size(), false);
+  for (size_t i = 0; i < order.size(); i++) {
+    size_t index = order[i];
+
+    // Repeated keys are only looked up once
+    if (i > 0 && mdbx_cmp(txn_, dbiHandle, &keys[order[i - 1]], &keys[index]) == 0) {
+      values[index] = values[order[i - 1]];
+      found[index] = found[order[i - 1]];
+      continue;
+    }
+
+    MDBX_val key = keys[index];
+    rc = mdbx_cursor_get(cursor, &key, &values[index], MDBX_SET_KEY);
+    if (rc == MDBX_SUCCESS) {
+      found[index] = true;
+    } else if (rc != MDBX_NOTFOUND) {
+      mdbx_cursor_close(cursor);
+      Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+  mdbx_cursor_close(cursor);
+
+  // Each decompressed value gets its own scratch string, which stays put
+  // until the results are built
+  std::vector<std::string> scratch(dbi->compression_ ? values.size() : 0);
+  for (size_t i = 0; i < scratch.size(); i++) {
+    if (found[i]) {
+      rc = dbi->LoadValue(txn_, values[i], scratch[i]);
+      if (rc != MDBX_SUCCESS) {
+        Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+        return env.Null();
+      }
+    }
+  }
+  for (size_t i = 0; i < values.size(); i++) {
+    metrics_->Read(found[i] ? MDBX_SUCCESS : MDBX_NOTFOUND, values[i].iov_len);
+  }
+
+  // Results come back in the order the keys were given
+  if (packed) {
+    size_t total = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      total += PackedSize(found[i] ? &values[i] : nullptr);
+    }
+    Napi::Buffer<char> result = Napi::Buffer<char>::New(env, total);
+    char* out = result.Data();
+    for (size_t i = 0; i < values.size(); i++) {
+      out = PackRecord(out, found[i] ? &values[i] : nullptr);
+    }
+    return result;
+  }
+
+  Napi::Array result = Napi::Array::New(env, values.size());
+  for (size_t i = 0; i < values.size(); i++) {
+    if (found[i]) {
+      result.Set(static_cast<uint32_t>(i), WrapValue(env, values[i]));
+    } else {
+      result.Set(static_cast<uint32_t>(i), env.Null());
+    }
+  }
+  return result;
+}
+
+Napi::Value MdbxTxn::GetAsync(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsBuffer()) {
+    Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Write transactions, and read transactions of environments opened without
+  // MDBX_NOTLS, are bound to the thread that began them and cannot be handed
+  // to the threadpool.
+  MDBX_env* mdbxEnv = mdbx_txn_env(txn_);
+  unsigned envFlags = 0;
+  mdbx_env_get_flags(mdbxEnv, &envFlags);
+  if (!isReadOnly_ || !(envFlags & MDBX_NOTLS)) {
+    Napi::Error::New(env, "getAsync requires a read-only transaction in an environment opened with NOTLS").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Object dbiObj = info[0].As<Napi::Object>();
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(dbiObj);
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Refresh the handle's per-transaction state here, before any worker holds
+  // the transaction; the workers themselves take turns on asyncMutex_.
+  MDBX_stat stat;
+  int rc = mdbx_dbi_stat(txn_, dbi->dbi_, &stat, sizeof(stat));
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
+
+  MdbxGetWorker* worker = new MdbxGetWorker(env, &pendingAsync_, {info.This().As<Napi::Object>(), dbiObj},
+                                            mdbxEnv, txn_, &asyncMutex_, dbi->dbi_, dbi->compression_,
+                                            keyBuffer.Data(), keyBuffer.Length());
+  Napi::Promise promise = worker->Promise();
+  worker->Queue();
+  return promise;
 }
 
 void MdbxTxn::Put(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
-  if (info.Length() < 3 || !info[0].IsObject() || !info[1].IsBuffer() || !info[2].IsBuffer()) {
-    Napi::TypeError::New(env, "Expected database, key buffer, and value buffer").ThrowAsJavaScriptException();
+  MDBX_val key, data;
+  if (info.Length() < 3 || !info[0].IsObject() || !SharedKey::Resolve(info[1], key) ||
+      !SharedKey::ResolveValue(info[2], data)) {
+    Napi::TypeError::New(env, "Expected database, key, and value buffer or string").ThrowAsJavaScriptException();
     return;
   }
 
@@ -213,32 +776,206 @@ void MdbxTxn::Put(const Napi::CallbackInfo& info) {
     return;
   }
 
-  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
-  Napi::Buffer<char> valueBuffer = info[2].As<Napi::Buffer<char>>();
   
   unsigned int flags = 0;
   if (info.Length() > 3 && info[3].IsNumber()) {
     flags = info[3].ToNumber().Uint32Value();
   }
 
+  static thread_local std::string stored;
+  MdbxMetrics::Timer timer(metrics_, MdbxMetrics::PUT);
+  int rc = MdbxCore::Put(txn_, dbi->dbi_, dbi->compression_.get(), key, data,
+                          static_cast<MDBX_put_flags_t>(flags), stored);
+  if (rc == MDBX_SUCCESS) {
+    metrics_->Wrote(data.iov_len);
+  }
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+void MdbxTxn::PutEncoded(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
   MDBX_val key, data;
-  key.iov_base = keyBuffer.Data();
-  key.iov_len = keyBuffer.Length();
-  data.iov_base = valueBuffer.Data();
-  data.iov_len = valueBuffer.Length();
+  if (info.Length() < 3 || !info[0].IsObject() || !SharedKey::Resolve(info[1], key)) {
+    Napi::TypeError::New(env, "Expected database, key buffer, and value").ThrowAsJavaScriptException();
+    return;
+  }
 
-  int rc = mdbx_put(txn_, dbi->dbi_, &key, &data, static_cast<MDBX_put_flags_t>(flags));
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (isReadOnly_) {
+    Napi::Error::New(env, "Cannot write to a read-only transaction").ThrowAsJavaScriptException();
+    return;
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return;
+  }
+
+  unsigned int flags = 0;
+  if (info.Length() > 3 && info[3].IsNumber()) {
+    flags = info[3].ToNumber().Uint32Value();
+  }
+
+  // Getters run while encoding may reuse the shared key area
+  std::string sharedKey;
+  if (!info[1].IsBuffer()) {
+    sharedKey.assign(static_cast<const char*>(key.iov_base), key.iov_len);
+    key.iov_base = &sharedKey[0];
+  }
+
+  // The value is encoded into a buffer reused across calls, which mdbx_put
+  // then copies into the page. It is taken out of the thread's slot while in
+  // use, so a getter or toJSON that puts another value during the encode
+  // gets a buffer of its own instead of clearing this one.
+  static thread_local std::string scratch;
+  std::string value;
+  value.swap(scratch);
+  value.clear();
+  if (dbi->structures_) {
+    // Objects are written as records of a structure, defining it in this
+    // transaction the first time its fields are seen
+    MdbxStructures::Session session(*dbi->structures_, txn_, true);
+    bool encoded = Msgpack::Encode(env, info[2], value, &session);
+    if (session.Defined() &&
+        std::find(structures_.begin(), structures_.end(), dbi->structures_) == structures_.end()) {
+      structures_.push_back(dbi->structures_);
+    }
+    if (!encoded) {
+      return;
+    }
+  } else if (!Msgpack::Encode(env, info[2], value)) {
+    return;
+  }
+
+  data.iov_base = &value[0];
+  data.iov_len = value.size();
+  static thread_local std::string stored;
+  MdbxMetrics::Timer timer(metrics_, MdbxMetrics::PUT);
+  int rc = MdbxCore::Put(txn_, dbi->dbi_, dbi->compression_.get(), key, data,
+                          static_cast<MDBX_put_flags_t>(flags), stored);
+  if (rc == MDBX_SUCCESS) {
+    metrics_->Wrote(data.iov_len);
+  }
+  scratch.swap(value);
   if (rc != MDBX_SUCCESS) {
     Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
     return;
   }
 }
 
+Napi::Value MdbxTxn::PutMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  bool packed = info.Length() >= 2 && info[1].IsBuffer();
+  if (info.Length() < 2 || !info[0].IsObject() ||
+      !(packed || (info.Length() >= 3 && info[1].IsArray() && info[2].IsArray()))) {
+    Napi::TypeError::New(env, "Expected database and a packed buffer, or arrays of key and value buffers").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (isReadOnly_) {
+    Napi::Error::New(env, "Cannot write to a read-only transaction").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  MdbxDbi* dbi = Napi::ObjectWrap<MdbxDbi>::Unwrap(info[0].As<Napi::Object>());
+  if (!dbi) {
+    Napi::TypeError::New(env, "Invalid database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Records alternate key, value and point into the caller's buffers
+  std::vector<MDBX_val> records;
+  size_t flagsArg = packed ? 2 : 3;
+  if (packed) {
+    Napi::Buffer<char> buffer = info[1].As<Napi::Buffer<char>>();
+    if (!UnpackRecords(buffer.Data(), buffer.Length(), records) || records.size() % 2 != 0) {
+      Napi::TypeError::New(env, "Malformed packed key-value buffer").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  } else {
+    Napi::Array keyArray = info[1].As<Napi::Array>();
+    Napi::Array valueArray = info[2].As<Napi::Array>();
+    if (keyArray.Length() != valueArray.Length()) {
+      Napi::TypeError::New(env, "Keys and values must have the same length").ThrowAsJavaScriptException();
+      return env.Null();
+    }
+
+    records.reserve(keyArray.Length() * 2);
+    for (uint32_t i = 0; i < keyArray.Length(); i++) {
+      Napi::Value key = keyArray.Get(i);
+      Napi::Value value = valueArray.Get(i);
+      if (!key.IsBuffer() || !value.IsBuffer()) {
+        Napi::TypeError::New(env, "Keys and values must be buffers").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+
+      MDBX_val record;
+      record.iov_base = key.As<Napi::Buffer<char>>().Data();
+      record.iov_len = key.As<Napi::Buffer<char>>().Length();
+      records.push_back(record);
+      record.iov_base = value.As<Napi::Buffer<char>>().Data();
+      record.iov_len = value.As<Napi::Buffer<char>>().Length();
+      records.push_back(record);
+    }
+  }
+
+  unsigned int flags = 0;
+  if (info.Length() > flagsArg && info[flagsArg].IsNumber()) {
+    flags = info[flagsArg].ToNumber().Uint32Value();
+  }
+
+  MDBX_cursor* cursor;
+  int rc = mdbx_cursor_open(txn_, dbi->dbi_, &cursor);
+  if (rc != MDBX_SUCCESS) {
+    Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  // Records rejected by MDBX_NOOVERWRITE or MDBX_NODUPDATA are skipped rather
+  // than failing the whole batch
+  uint32_t written = 0;
+  std::string stored;
+  for (size_t i = 0; i < records.size(); i += 2) {
+    size_t length = records[i + 1].iov_len;
+    dbi->StoreValue(records[i + 1], stored);
+    rc = mdbx_cursor_put(cursor, &records[i], &records[i + 1], static_cast<MDBX_put_flags_t>(flags));
+    if (rc == MDBX_SUCCESS) {
+      metrics_->Wrote(length);
+      written++;
+    } else if (rc != MDBX_KEYEXIST) {
+      mdbx_cursor_close(cursor);
+      Napi::Error::New(env, mdbx_strerror(rc)).ThrowAsJavaScriptException();
+      return env.Null();
+    }
+  }
+  mdbx_cursor_close(cursor);
+
+  return Napi::Number::New(env, written);
+}
+
 Napi::Value MdbxTxn::Del(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
-  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsBuffer()) {
+  MDBX_val key, data;
+  if (info.Length() < 2 || !info[0].IsObject() || !SharedKey::Resolve(info[1], key)) {
     Napi::TypeError::New(env, "Expected database and key buffer").ThrowAsJavaScriptException();
     return Napi::Boolean::New(env, false);
   }
@@ -259,12 +996,6 @@ Napi::Value MdbxTxn::Del(const Napi::CallbackInfo& info) {
     return Napi::Boolean::New(env, false);
   }
 
-  Napi::Buffer<char> keyBuffer = info[1].As<Napi::Buffer<char>>();
-  
-  MDBX_val key, data;
-  key.iov_base = keyBuffer.Data();
-  key.iov_len = keyBuffer.Length();
-
   // Check if value is provided (for DUPSORT databases)
   if (info.Length() > 2 && info[2].IsBuffer()) {
     Napi::Buffer<char> valueBuffer = info[2].As<Napi::Buffer<char>>();
@@ -288,5 +1019,23 @@ Napi::Value MdbxTxn::Del(const Napi::CallbackInfo& info) {
     }
   }
 
+  metrics_->Add(MdbxMetrics::DELS);
   return Napi::Boolean::New(env, true);
+}
+
+Napi::Value MdbxTxn::Bind(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Expected database object").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!txn_) {
+    Napi::Error::New(env, "Transaction already committed or aborted").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  return MdbxHandle::constructor.New({info.This(), info[0]});
 }
\ No newline at end of file
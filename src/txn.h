@@ -2,13 +2,18 @@
 #define MDBX_TXN_H
 
 #include <napi.h>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "mdbx_wrapper.h"
 #include "env.h"
 
+class MdbxStructures;
+
 class MdbxTxn : public Napi::ObjectWrap<MdbxTxn> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
-  static Napi::FunctionReference constructor;
+  static thread_local Napi::FunctionReference constructor;
   
   MdbxTxn(const Napi::CallbackInfo& info);
   ~MdbxTxn();
@@ -16,16 +21,70 @@ class MdbxTxn : public Napi::ObjectWrap<MdbxTxn> {
   // MDBX transaction
   MDBX_txn* txn_;
   bool isReadOnly_;
+  bool isReset_ = false;
+  unsigned int flags_ = 0;
+  MdbxEnv* env_ = nullptr;
+  // Keeps the environment alive for as long as this transaction
+  Napi::ObjectReference envRef_;
+  // The shared environment's metrics, which outlive this transaction
+  MdbxMetrics* metrics_ = nullptr;
+  // Return Buffers that point straight into the memory map
+  bool zeroCopy_ = false;
+
+  // Wraps bytes read through this transaction in a Buffer. In zero-copy mode
+  // the Buffer is backed by the mapped page, unless the page is dirty and may
+  // still change within this write transaction.
+  Napi::Buffer<char> WrapValue(Napi::Env env, const MDBX_val& val);
+  // Reads the target of getInto(): a Buffer or ArrayBuffer and an optional
+  // byte offset into it. Returns false when either is unusable.
+  static bool ResolveTarget(const Napi::Value& target, const Napi::Value& offset,
+                            char*& out, size_t& room);
+  // Copies a value read by getInto() into its target, returning the value's
+  // length, or the length negated when `room` is too small and nothing was
+  // copied
+  static Napi::Value CopyInto(Napi::Env env, const MDBX_val& val, char* out, size_t room);
+  // Async reads still running against txn_ on the threadpool
+  int pendingAsync_ = 0;
+  // A transaction may only be used by one thread at a time, so the async
+  // reads sharing txn_ take turns
+  std::mutex asyncMutex_;
+  // Parent of a nested transaction, kept alive until this one ends
+  MdbxTxn* parent_ = nullptr;
+  Napi::ObjectReference parentRef_;
   
   // Node.js methods
   void Abort(const Napi::CallbackInfo& info);
-  void Commit(const Napi::CallbackInfo& info);
+  Napi::Value Commit(const Napi::CallbackInfo& info);
+  Napi::Value CommitAsync(const Napi::CallbackInfo& info);
   void Reset(const Napi::CallbackInfo& info);
   void Renew(const Napi::CallbackInfo& info);
   
   Napi::Value Get(const Napi::CallbackInfo& info);
+  Napi::Value GetString(const Napi::CallbackInfo& info);
+  Napi::Value GetInto(const Napi::CallbackInfo& info);
+  Napi::Value GetMany(const Napi::CallbackInfo& info);
+  Napi::Value GetDecoded(const Napi::CallbackInfo& info);
+  Napi::Value GetAsync(const Napi::CallbackInfo& info);
   void Put(const Napi::CallbackInfo& info);
+  Napi::Value PutMany(const Napi::CallbackInfo& info);
+  void PutEncoded(const Napi::CallbackInfo& info);
   Napi::Value Del(const Napi::CallbackInfo& info);
+  Napi::Value Bind(const Napi::CallbackInfo& info);
+
+ private:
+  // Ends the transaction, handing read-only ones back to the env's pool
+  int Finish(bool commit, MDBX_commit_latency* latency = nullptr);
+  // Detaches every zero-copy Buffer still alive, since its page may be
+  // reused once the snapshot is released
+  void DetachMapped();
+
+  // Settles the record structures defined within this transaction
+  void EndStructures(MDBX_txn* txn, bool committed);
+
+  std::vector<Napi::Reference<Napi::ArrayBuffer>> mapped_;
+  // Structure caches holding definitions made by this transaction
+  std::vector<std::shared_ptr<MdbxStructures>> structures_;
+  size_t mappedCompactAt_ = 64;
 };
 
 #endif // MDBX_TXN_H
\ No newline at end of file
@@ -0,0 +1,24 @@
+#include "utf8.h"
+
+namespace Utf8 {
+
+void Encode(const Napi::Value& string, std::string& out) {
+  napi_env env = string.Env();
+  size_t length = 0;
+
+  // Try the capacity at hand first. V8 stops before a character that doesn't
+  // fit whole, so a truncated result can be up to 3 bytes short of the room
+  // given; only a result at least 4 bytes short is known to be complete.
+  out.resize(out.capacity() > 64 ? out.capacity() : 64);
+  napi_get_value_string_utf8(env, string, &out[0], out.size() + 1, &length);
+  if (length + 4 <= out.size()) {
+    out.resize(length);
+    return;
+  }
+
+  napi_get_value_string_utf8(env, string, nullptr, 0, &length);
+  out.resize(length);
+  napi_get_value_string_utf8(env, string, &out[0], length + 1, &length);
+}
+
+}  // namespace Utf8
\ No newline at end of file
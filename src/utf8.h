@@ -0,0 +1,16 @@
+#ifndef MDBX_UTF8_H
+#define MDBX_UTF8_H
+
+#include <napi.h>
+#include <string>
+
+namespace Utf8 {
+
+// UTF-8 encodes a JS string into `out`, replacing its contents, without
+// going through a Buffer. Strings that fit the capacity `out` already has
+// take a single copy.
+void Encode(const Napi::Value& string, std::string& out);
+
+}  // namespace Utf8
+
+#endif // MDBX_UTF8_H
\ No newline at end of file
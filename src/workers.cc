@@ -0,0 +1,173 @@
+#include "workers.h"
+#include "commitstats.h"
+#include "metrics.h"
+
+MdbxPromiseWorker::MdbxPromiseWorker(Napi::Env env, int* pending,
+                                     std::initializer_list<Napi::Object> keepAlive)
+  : Napi::AsyncWorker(env),
+    deferred_(Napi::Promise::Deferred::New(env)),
+    pending_(pending) {
+  for (const Napi::Object& obj : keepAlive) {
+    refs_.push_back(Napi::Persistent(obj));
+  }
+  ++*pending_;
+}
+
+void MdbxPromiseWorker::OnOK() {
+  --*pending_;
+  deferred_.Resolve(Result(Env()));
+}
+
+void MdbxPromiseWorker::OnError(const Napi::Error& e) {
+  --*pending_;
+  deferred_.Reject(e.Value());
+}
+
+MdbxGetWorker::MdbxGetWorker(Napi::Env env, int* pending,
+                             std::initializer_list<Napi::Object> keepAlive,
+                             MDBX_env* mdbxEnv, MDBX_txn* txn, std::mutex* txnMutex, MDBX_dbi dbi,
+                             std::shared_ptr<MdbxCompression> compression,
+                             const char* key, size_t keyLen)
+  : MdbxPromiseWorker(env, pending, keepAlive),
+    env_(mdbxEnv), txn_(txn), txnMutex_(txnMutex), dbi_(dbi), compression_(compression),
+    key_(key, keyLen) {
+}
+
+void MdbxGetWorker::Execute() {
+  MDBX_txn* txn = txn_;
+  int rc;
+
+  std::unique_lock<std::mutex> lock;
+  if (txn) {
+    lock = std::unique_lock<std::mutex>(*txnMutex_);
+  } else {
+    rc = mdbx_txn_begin(env_, nullptr, MDBX_TXN_RDONLY, &txn);
+    if (rc != MDBX_SUCCESS) {
+      SetError(mdbx_strerror(rc));
+      return;
+    }
+  }
+
+  MDBX_val key, data;
+  key.iov_base = const_cast<char*>(key_.data());
+  key.iov_len = key_.size();
+
+  MdbxMetrics* metrics = MdbxMetrics::Of(env_);
+  MdbxMetrics::Timer timer(metrics, MdbxMetrics::GET);
+  rc = mdbx_get(txn, dbi_, &key, &data);
+  if (rc == MDBX_SUCCESS && compression_) {
+    // Expanding the value copies it out as well, unless it was stored raw
+    MDBX_val stored = data;
+    rc = compression_->Decompress(txn, stored, data, value_);
+  }
+  if (rc == MDBX_SUCCESS) {
+    // Copy out while the snapshot is still pinned
+    if (data.iov_base != value_.data()) {
+      value_.assign(static_cast<const char*>(data.iov_base), data.iov_len);
+    }
+    found_ = true;
+  }
+  if (metrics) {
+    metrics->Read(rc, data.iov_len);
+  }
+
+  if (!txn_) {
+    mdbx_txn_abort(txn);
+  }
+
+  if (rc != MDBX_SUCCESS && rc != MDBX_NOTFOUND) {
+    SetError(mdbx_strerror(rc));
+  }
+}
+
+Napi::Value MdbxGetWorker::Result(Napi::Env env) {
+  if (!found_) {
+    return env.Null();
+  }
+  return Napi::Buffer<char>::Copy(env, value_.data(), value_.size());
+}
+
+MdbxWriteWorker::MdbxWriteWorker(Napi::Env env, int* pending,
+                                 std::initializer_list<Napi::Object> keepAlive,
+                                 MDBX_env* mdbxEnv, MDBX_dbi dbi, bool isDelete,
+                                 const char* key, size_t keyLen,
+                                 const char* value, size_t valueLen, bool hasValue,
+                                 unsigned int flags)
+  : MdbxPromiseWorker(env, pending, keepAlive),
+    env_(mdbxEnv), dbi_(dbi), isDelete_(isDelete),
+    key_(key, keyLen), value_(hasValue ? std::string(value, valueLen) : std::string()),
+    hasValue_(hasValue), flags_(flags) {
+}
+
+void MdbxWriteWorker::Execute() {
+  // Write transactions are bound to the thread that began them, so the whole
+  // begin/put/commit sequence has to happen here on the threadpool thread.
+  MDBX_txn* txn;
+  int rc = mdbx_txn_begin(env_, nullptr, MDBX_TXN_READWRITE, &txn);
+  if (rc != MDBX_SUCCESS) {
+    SetError(mdbx_strerror(rc));
+    return;
+  }
+
+  MDBX_val key, data;
+  key.iov_base = const_cast<char*>(key_.data());
+  key.iov_len = key_.size();
+  data.iov_base = const_cast<char*>(value_.data());
+  data.iov_len = value_.size();
+
+  MdbxMetrics* metrics = MdbxMetrics::Of(env_);
+  if (isDelete_) {
+    rc = mdbx_del(txn, dbi_, &key, hasValue_ ? &data : nullptr);
+    if (rc == MDBX_NOTFOUND) {
+      found_ = false;
+      rc = MDBX_SUCCESS;
+    } else if (rc == MDBX_SUCCESS && metrics) {
+      metrics->Add(MdbxMetrics::DELS);
+    }
+  } else {
+    MdbxMetrics::Timer timer(metrics, MdbxMetrics::PUT);
+    rc = mdbx_put(txn, dbi_, &key, &data, static_cast<MDBX_put_flags_t>(flags_));
+    if (rc == MDBX_SUCCESS && metrics) {
+      metrics->Wrote(data.iov_len);
+    }
+  }
+
+  if (rc == MDBX_SUCCESS) {
+    rc = MdbxCommitStats::Commit(txn);
+  } else {
+    mdbx_txn_abort(txn);
+  }
+  if (metrics) {
+    metrics->Add(MdbxMetrics::TXNS_BEGUN);
+    metrics->Add(rc == MDBX_SUCCESS ? MdbxMetrics::TXNS_COMMITTED : MdbxMetrics::TXNS_ABORTED);
+  }
+
+  if (rc != MDBX_SUCCESS) {
+    SetError(mdbx_strerror(rc));
+  }
+}
+
+Napi::Value MdbxWriteWorker::Result(Napi::Env env) {
+  if (isDelete_) {
+    return Napi::Boolean::New(env, found_);
+  }
+  return env.Undefined();
+}
+
+MdbxSyncWorker::MdbxSyncWorker(Napi::Env env, int* pending,
+                               std::initializer_list<Napi::Object> keepAlive,
+                               MDBX_env* mdbxEnv)
+  : MdbxPromiseWorker(env, pending, keepAlive), env_(mdbxEnv) {
+}
+
+void MdbxSyncWorker::Execute() {
+  int rc = mdbx_env_sync_ex(env_, true, false);
+  // MDBX_RESULT_TRUE means there was nothing left to flush
+  if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE) {
+    SetError(mdbx_strerror(rc));
+  }
+}
+
+Napi::Value MdbxSyncWorker::Result(Napi::Env env) {
+  return env.Undefined();
+}
\ No newline at end of file
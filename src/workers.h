@@ -0,0 +1,103 @@
+#ifndef MDBX_WORKERS_H
+#define MDBX_WORKERS_H
+
+#include <napi.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "mdbx_wrapper.h"
+#include "compression.h"
+
+// Base class for operations that run on the libuv threadpool and settle a
+// promise. The JS objects named in `keepAlive` (environment, transaction...)
+// are referenced until the worker completes so they cannot be collected while
+// the threadpool is still using their native handles.
+class MdbxPromiseWorker : public Napi::AsyncWorker {
+ public:
+  MdbxPromiseWorker(Napi::Env env, int* pending,
+                    std::initializer_list<Napi::Object> keepAlive);
+
+  Napi::Promise Promise() const { return deferred_.Promise(); }
+
+ protected:
+  void OnOK() override;
+  void OnError(const Napi::Error& e) override;
+  virtual Napi::Value Result(Napi::Env env) = 0;
+
+  Napi::Promise::Deferred deferred_;
+  int* pending_;
+  std::vector<Napi::ObjectReference> refs_;
+};
+
+// Reads a single value. When `txn` is null the worker opens its own read-only
+// transaction on the threadpool thread, otherwise it reads through `txn`, which
+// must be a read-only transaction of an MDBX_NOTLS environment, holding
+// `txnMutex` so workers sharing it never use it at the same time. Values of a
+// compressed database are expanded on the threadpool as well.
+class MdbxGetWorker : public MdbxPromiseWorker {
+ public:
+  MdbxGetWorker(Napi::Env env, int* pending,
+                std::initializer_list<Napi::Object> keepAlive,
+                MDBX_env* mdbxEnv, MDBX_txn* txn, std::mutex* txnMutex, MDBX_dbi dbi,
+                std::shared_ptr<MdbxCompression> compression,
+                const char* key, size_t keyLen);
+
+ protected:
+  void Execute() override;
+  Napi::Value Result(Napi::Env env) override;
+
+ private:
+  MDBX_env* env_;
+  MDBX_txn* txn_;
+  std::mutex* txnMutex_;
+  MDBX_dbi dbi_;
+  std::shared_ptr<MdbxCompression> compression_;
+  std::string key_;
+  std::string value_;
+  bool found_ = false;
+};
+
+// Writes or deletes a single record in its own write transaction, which is
+// begun and committed on the threadpool thread.
+class MdbxWriteWorker : public MdbxPromiseWorker {
+ public:
+  MdbxWriteWorker(Napi::Env env, int* pending,
+                  std::initializer_list<Napi::Object> keepAlive,
+                  MDBX_env* mdbxEnv, MDBX_dbi dbi, bool isDelete,
+                  const char* key, size_t keyLen,
+                  const char* value, size_t valueLen, bool hasValue,
+                  unsigned int flags);
+
+ protected:
+  void Execute() override;
+  Napi::Value Result(Napi::Env env) override;
+
+ private:
+  MDBX_env* env_;
+  MDBX_dbi dbi_;
+  bool isDelete_;
+  std::string key_;
+  std::string value_;
+  bool hasValue_;
+  unsigned int flags_;
+  bool found_ = true;
+};
+
+// Flushes the environment to disk, used to make a commit made with
+// MDBX_TXN_NOSYNC durable without blocking the JS thread.
+class MdbxSyncWorker : public MdbxPromiseWorker {
+ public:
+  MdbxSyncWorker(Napi::Env env, int* pending,
+                 std::initializer_list<Napi::Object> keepAlive,
+                 MDBX_env* mdbxEnv);
+
+ protected:
+  void Execute() override;
+  Napi::Value Result(Napi::Env env) override;
+
+ private:
+  MDBX_env* env_;
+};
+
+#endif // MDBX_WORKERS_H
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "writer.h"
+#include "commitstats.h"
+#include "metrics.h"
+#include <chrono>
+
+MdbxWriter::MdbxWriter(Napi::Env env, MDBX_env* mdbxEnv)
+  : env_(mdbxEnv), js_(std::make_shared<JsState>()) {
+  Napi::Function noop = Napi::Function::New(env, [](const Napi::CallbackInfo&) {});
+  js_->tsfn = Napi::ThreadSafeFunction::New(env, noop, "mdbxjs.writer", 0, 1);
+  // Only keep the event loop alive while operations are in flight
+  js_->tsfn.Unref(env);
+
+  thread_ = std::thread(&MdbxWriter::Run, this);
+}
+
+MdbxWriter::~MdbxWriter() {
+  Stop();
+}
+
+Napi::Promise MdbxWriter::Put(Napi::Env env, MDBX_dbi dbi,
+                              const char* key, size_t keyLen,
+                              const char* value, size_t valueLen,
+                              unsigned int flags) {
+  return Enqueue(env, Op{OP_PUT, dbi, std::string(key, keyLen), std::string(value, valueLen),
+                         true, flags, Napi::Promise::Deferred::New(env), MDBX_SUCCESS, true});
+}
+
+Napi::Promise MdbxWriter::Del(Napi::Env env, MDBX_dbi dbi,
+                              const char* key, size_t keyLen,
+                              const char* value, size_t valueLen, bool hasValue) {
+  return Enqueue(env, Op{OP_DEL, dbi, std::string(key, keyLen),
+                         hasValue ? std::string(value, valueLen) : std::string(),
+                         hasValue, 0, Napi::Promise::Deferred::New(env), MDBX_SUCCESS, true});
+}
+
+Napi::Promise MdbxWriter::Flush(Napi::Env env) {
+  return Enqueue(env, Op{OP_FLUSH, 0, std::string(), std::string(),
+                         false, 0, Napi::Promise::Deferred::New(env), MDBX_SUCCESS, true});
+}
+
+Napi::Promise MdbxWriter::Enqueue(Napi::Env env, Op op) {
+  Napi::Promise promise = op.deferred.Promise();
+
+  if (js_->released) {
+    op.deferred.Reject(Napi::Error::New(env, "Writer is stopped").Value());
+    return promise;
+  }
+
+  if (js_->inFlight++ == 0) {
+    js_->tsfn.Ref(env);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(op));
+  }
+  cv_.notify_one();
+
+  return promise;
+}
+
+void MdbxWriter::Stop() {
+  if (js_->released) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  cv_.notify_one();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  // Batches already handed to the function are still delivered
+  js_->released = true;
+  js_->tsfn.Release();
+}
+
+void MdbxWriter::Run() {
+  for (;;) {
+    Batch* batch = new Batch();
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+      if (queue_.empty()) {
+        delete batch;
+        return;
+      }
+      batch->swap(queue_);
+    }
+
+    Apply(*batch);
+
+    std::shared_ptr<JsState> js = js_;
+    js_->tsfn.BlockingCall(batch, [js](Napi::Env env, Napi::Function, Batch* batch) {
+      Napi::HandleScope scope(env);
+
+      for (Op& op : *batch) {
+        if (op.rc != MDBX_SUCCESS) {
+          op.deferred.Reject(Napi::Error::New(env, mdbx_strerror(op.rc)).Value());
+        } else if (op.type == OP_DEL) {
+          op.deferred.Resolve(Napi::Boolean::New(env, op.found));
+        } else {
+          op.deferred.Resolve(env.Undefined());
+        }
+      }
+
+      js->inFlight -= batch->size();
+      if (js->inFlight == 0 && !js->released) {
+        js->tsfn.Unref(env);
+      }
+
+      delete batch;
+    });
+  }
+}
+
+int MdbxWriter::Begin(MDBX_txn** txn) {
+  std::chrono::microseconds backoff(50);
+  for (;;) {
+    int rc = mdbx_txn_begin(env_, nullptr, MDBX_TXN_TRY, txn);
+    if (rc != MDBX_BUSY) {
+      return rc;
+    }
+
+    // Another transaction holds the write lock, which may be one the JS
+    // thread keeps open while it waits in Stop()
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_) {
+      return MDBX_BUSY;
+    }
+    cv_.wait_for(lock, backoff);
+    if (backoff < std::chrono::milliseconds(5)) {
+      backoff *= 2;
+    }
+  }
+}
+
+void MdbxWriter::Apply(Batch& batch) {
+  MDBX_txn* txn;
+  int rc = Begin(&txn);
+  if (rc != MDBX_SUCCESS) {
+    for (Op& op : batch) {
+      op.rc = rc;
+    }
+    return;
+  }
+
+  MdbxMetrics* metrics = MdbxMetrics::Of(env_);
+  for (Op& op : batch) {
+    MDBX_val key, data;
+    key.iov_base = const_cast<char*>(op.key.data());
+    key.iov_len = op.key.size();
+    data.iov_base = const_cast<char*>(op.value.data());
+    data.iov_len = op.value.size();
+
+    if (op.type == OP_PUT) {
+      MdbxMetrics::Timer timer(metrics, MdbxMetrics::PUT);
+      op.rc = mdbx_put(txn, op.dbi, &key, &data, static_cast<MDBX_put_flags_t>(op.flags));
+      if (op.rc == MDBX_SUCCESS && metrics) {
+        metrics->Wrote(data.iov_len);
+      }
+    } else if (op.type == OP_DEL) {
+      op.rc = mdbx_del(txn, op.dbi, &key, op.hasValue ? &data : nullptr);
+      if (op.rc == MDBX_NOTFOUND) {
+        op.found = false;
+        op.rc = MDBX_SUCCESS;
+      } else if (op.rc == MDBX_SUCCESS && metrics) {
+        metrics->Add(MdbxMetrics::DELS);
+      }
+    }
+
+    // Errors such as MDBX_KEYEXIST only fail their own operation, but anything
+    // that breaks the transaction fails the whole batch
+    if (op.rc != MDBX_SUCCESS && (static_cast<unsigned>(mdbx_txn_flags(txn)) & MDBX_TXN_ERROR)) {
+      rc = op.rc;
+      break;
+    }
+  }
+
+  if (rc == MDBX_SUCCESS) {
+    rc = MdbxCommitStats::Commit(txn);
+  } else {
+    mdbx_txn_abort(txn);
+  }
+  if (metrics) {
+    metrics->Add(MdbxMetrics::TXNS_BEGUN);
+    metrics->Add(rc == MDBX_SUCCESS ? MdbxMetrics::TXNS_COMMITTED : MdbxMetrics::TXNS_ABORTED);
+  }
+
+  if (rc != MDBX_SUCCESS) {
+    for (Op& op : batch) {
+      op.rc = rc;
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#ifndef MDBX_WRITER_H
+#define MDBX_WRITER_H
+
+#include <napi.h>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "mdbx_wrapper.h"
+
+// Group-commit writer. A dedicated thread owns the environment's write
+// transaction: it drains every operation queued since the last commit, applies
+// them in one transaction, commits once and then settles all of their promises
+// together on the JS thread.
+class MdbxWriter {
+ public:
+  MdbxWriter(Napi::Env env, MDBX_env* mdbxEnv);
+  ~MdbxWriter();
+
+  Napi::Promise Put(Napi::Env env, MDBX_dbi dbi,
+                    const char* key, size_t keyLen,
+                    const char* value, size_t valueLen,
+                    unsigned int flags);
+  Napi::Promise Del(Napi::Env env, MDBX_dbi dbi,
+                    const char* key, size_t keyLen,
+                    const char* value, size_t valueLen, bool hasValue);
+  // Resolves once every operation queued before it has been committed
+  Napi::Promise Flush(Napi::Env env);
+
+  // Commits whatever is still queued and joins the writer thread. Operations
+  // that can't get the write lock because it is held elsewhere fail with
+  // MDBX_BUSY.
+  void Stop();
+
+ private:
+  enum OpType { OP_PUT, OP_DEL, OP_FLUSH };
+
+  struct Op {
+    OpType type;
+    MDBX_dbi dbi;
+    std::string key;
+    std::string value;
+    bool hasValue;
+    unsigned int flags;
+    Napi::Promise::Deferred deferred;
+    int rc;
+    bool found;
+  };
+
+  typedef std::vector<Op> Batch;
+
+  // State touched only on the JS thread, shared with pending settle callbacks
+  // which may run after the writer itself has been destroyed.
+  struct JsState {
+    Napi::ThreadSafeFunction tsfn;
+    size_t inFlight = 0;
+    bool released = false;
+  };
+
+  Napi::Promise Enqueue(Napi::Env env, Op op);
+  void Run();
+  void Apply(Batch& batch);
+  // Begins the write transaction without blocking on the write lock, so a
+  // writer stopped while the JS thread holds the lock gives up instead of
+  // deadlocking the join in Stop()
+  int Begin(MDBX_txn** txn);
+
+  MDBX_env* env_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  Batch queue_;
+  bool stopping_ = false;
+  std::shared_ptr<JsState> js_;
+};
+
+#endif // MDBX_WRITER_H
\ No newline at end of file
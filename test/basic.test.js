@@ -4,6 +4,7 @@ const mdbx = require('../lib');
 const fs = require('fs');
 const path = require('path');
 const os = require('os');
+const { Worker } = require('worker_threads');
 
 // Create a unique temp directory for tests
 const TEST_DIR = path.join(os.tmpdir(), 'mdbxjs-test-' + Date.now());
@@ -118,6 +119,297 @@ describe('Basic MDBXJS operations', () => {
     expect(result[1].value).toBe('two');
   });
 
+  test('Ordered key encoding sorts numbers, strings and tuples by value', () => {
+    const keys = [-1.5, -1, 0, 2, 10, 1e9, -(2n ** 70n), -1n, 0n, 255n, 2n ** 70n, '', 'a', 'a\0', 'ab', 'b', ['a', 1], ['a', 2], ['a', 2, 0], ['b']];
+    const encoded = keys.map((key) => mdbx.encodeKey(key));
+    const sorted = [...encoded].sort(Buffer.compare);
+    expect(sorted).toEqual(encoded);
+    expect(encoded.map((buffer) => mdbx.decodeKey(buffer))).toEqual(keys);
+
+    const target = Buffer.alloc(32);
+    const length = mdbx.encodeKey(42, target, 4);
+    expect(target.subarray(4, 4 + length)).toEqual(mdbx.encodeKey(42));
+
+    const collection = mdbx.collection(env, 'ordered-test', { keyEncoding: 'ordered' });
+    for (const id of [100, 9, -5, 20]) {
+      collection.put(id, `id${id}`);
+    }
+    const result = collection.find({ gte: 0, lt: 50 });
+    expect(result.map((entry) => entry.key)).toEqual([9, 20]);
+  });
+
+  test('Bound handles read and write raw buffers', () => {
+    const db = env.openDatabase({ name: 'bound-test' });
+    const txn = env.beginTransaction();
+    const handle = txn.bind(db);
+    handle.put(Buffer.from('key1'), Buffer.from('value1'));
+    expect(handle.get(Buffer.from('key1')).toString()).toBe('value1');
+    expect(txn.get(db, 'key1').toString()).toBe('value1');
+    expect(handle.get(mdbx.keyBuffer.write('key1')).toString()).toBe('value1');
+    handle.put(mdbx.keyBuffer.write('key2'), Buffer.from('value2'));
+    expect(txn.get(db, 'key2').toString()).toBe('value2');
+    expect(handle.del(Buffer.from('key1'))).toBe(true);
+    expect(handle.get(Buffer.from('key1'))).toBeNull();
+    txn.commit();
+    expect(() => handle.get(Buffer.from('key1'))).toThrow();
+    db.close();
+  });
+
+  test('String keys and values skip intermediate buffers', () => {
+    const db = env.openDatabase({ name: 'string-test' });
+    const txn = env.beginTransaction();
+    txn.put(db, 'greeting', 'h\u00e9llo \u{1f30d}');
+    expect(txn.getString(db, 'greeting')).toBe('h\u00e9llo \u{1f30d}');
+    expect(txn.getString(db, 'missing')).toBeNull();
+    const handle = txn.bind(db);
+    handle.put('long', 'x'.repeat(1000));
+    expect(handle.getString('long')).toBe('x'.repeat(1000));
+    expect(txn.get(db, 'long').length).toBe(1000);
+
+    // Multibyte characters straddling the end of the reused encode buffer,
+    // whatever its capacity by now
+    for (let n = 0; n < 1100; n++) {
+      const text = 'x'.repeat(n) + (n % 2 ? '\u00e9' : '\u{1f30d}');
+      txn.put(db, `straddle${n}`, text);
+      expect(txn.getString(db, `straddle${n}`)).toBe(text);
+      if (n < 200) {
+        txn.put(db, text, 'key');
+        expect(txn.getString(db, text)).toBe('key');
+      }
+    }
+    txn.commit();
+    db.close();
+  });
+
+  test('getInto copies values into a caller buffer', () => {
+    const db = env.openDatabase({ name: 'into-test' });
+    const txn = env.beginTransaction();
+    txn.put(db, 'key1', 'value1');
+    const target = Buffer.alloc(16);
+    expect(txn.getInto(db, 'key1', target, 2)).toBe(6);
+    expect(target.subarray(2, 8).toString()).toBe('value1');
+    expect(txn.getInto(db, 'key1', Buffer.alloc(3))).toBe(-6);
+    expect(txn.getInto(db, 'missing', target)).toBeNull();
+    const arrayBuffer = new ArrayBuffer(8);
+    expect(txn.bind(db).getInto('key1', arrayBuffer)).toBe(6);
+    expect(Buffer.from(arrayBuffer, 0, 6).toString()).toBe('value1');
+    txn.commit();
+    db.close();
+  });
+
+  test('Commits report their latency breakdown', () => {
+    const db = env.openDatabase({ name: 'latency-test' });
+    env.commitStats({ reset: true });
+    const txn = env.beginTransaction();
+    txn.put(db, 'key1', 'value1');
+    const latency = txn.commit();
+    expect(latency.whole).toBeGreaterThanOrEqual(latency.write);
+    const stats = env.commitStats();
+    expect(stats.whole.count).toBe(1);
+    expect(stats.sync.buckets.reduce((a, b) => a + b, 0)).toBe(1);
+    db.close();
+  });
+
+  test('Environment metrics count operations', () => {
+    const db = env.openDatabase({ name: 'metrics-test' });
+    env.metrics({ reset: true });
+    const txn = env.beginTransaction();
+    txn.put(db, 'key1', 'value1');
+    txn.get(db, 'key1');
+    txn.get(db, 'missing');
+    txn.del(db, 'key1');
+    txn.commit();
+
+    const metrics = env.metrics();
+    expect(metrics).toMatchObject({ gets: 2, hits: 1, misses: 1, puts: 1, dels: 1, bytesRead: 6, bytesWritten: 6 });
+    expect(metrics.txnsCommitted).toBeGreaterThanOrEqual(1);
+    expect(metrics.latency.commit.count).toBeGreaterThanOrEqual(1);
+    expect(env.metrics().gets).toBe(2);
+    db.close();
+  });
+
+  test('Reader table lists active readers', () => {
+    const txn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    const readers = env.readers();
+    expect(readers.some((reader) => reader.pid === process.pid)).toBe(true);
+    expect(env.checkReaders()).toBe(0);
+    txn.abort();
+  });
+
+  test('Slow reader policy is validated on open', () => {
+    const other = new mdbx.Environment();
+    const dir = path.join(TEST_DIR, 'slow-readers-' + Date.now());
+    expect(() => other.open({ path: dir, slowReaders: { policy: 'ignore' } })).toThrow(/slowReaders.policy/);
+    other.open({ path: dir, slowReaders: { policy: 'wait', waitMs: 100 } });
+    expect(other.metrics().slowReaders).toBe(0);
+    other.close();
+  });
+
+  test('Slow reader policy runs when a pinned reader fills the map', () => {
+    const small = mdbx.open(path.join(TEST_DIR, 'slow-readers-full-' + Date.now()), {
+      mapSize: 1024 * 1024,
+      slowReaders: { policy: 'wait', waitMs: 20 }
+    });
+    const db = small.openDatabase({ name: 'fill', create: true });
+    const value = Buffer.alloc(64 * 1024, 1);
+    const write = () => {
+      const txn = small.beginTransaction();
+      try {
+        txn.put(db, 'key', value);
+      } catch (error) {
+        txn.abort();
+        throw error;
+      }
+      txn.commit();
+    };
+    write();
+
+    // Every rewrite frees the previous value's pages, but the reader's
+    // snapshot keeps them from being reused until the map runs out
+    const reader = small.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    expect(() => {
+      for (let i = 0; i < 100; i++) write();
+    }).toThrow(/MAP_FULL/);
+    expect(small.metrics().slowReaders).toBeGreaterThan(0);
+    expect(reader.get(db, 'key').length).toBe(value.length);
+
+    reader.abort();
+    write();
+    small.close();
+  });
+
+  test('MessagePack values round-trip rich types', () => {
+    const value = {
+      name: 'msgpack',
+      count: 42,
+      ratio: -0.1,
+      big: -(2n ** 80n),
+      when: new Date(Date.UTC(2020, 1, 3, 4, 5, 6, 789)),
+      tags: new Map([['a', 1], [2, [true, null]]]),
+      floats: new Float64Array([1.5, -2]),
+      shorts: new Int16Array([-300, 7]),
+      longs: new BigInt64Array([-(2n ** 40n)]),
+      bytes: Buffer.from('raw'),
+      nested: [{ deep: 'x'.repeat(300) }]
+    };
+    expect(mdbx.decodeValue(mdbx.encodeValue(value))).toEqual(value);
+
+    const collection = mdbx.collection(env, 'msgpack-test', { valueEncoding: 'msgpack' });
+    collection.put('key1', value);
+    expect(collection.get('key1')).toEqual(value);
+    expect(collection.get('missing')).toBeNull();
+    expect(collection.find({ gte: 'key1' })[0].value).toEqual(value);
+  });
+
+  test('MessagePack puts made while encoding another value are independent', () => {
+    const db = env.openDatabase({ name: 'reentrant-test', valueEncoding: 'msgpack' });
+    const txn = env.beginTransaction();
+    txn.put(db, 'outer', {
+      get text() {
+        txn.put(db, 'inner', { n: 2 });
+        return 'x'.repeat(100);
+      }
+    });
+    expect(txn.getDecoded(db, 'outer')).toEqual({ text: 'x'.repeat(100) });
+    expect(txn.getDecoded(db, 'inner')).toEqual({ n: 2 });
+    txn.abort();
+  });
+
+  test('MessagePack records share their structure', () => {
+    const db = env.openDatabase({ name: 'structures-test', valueEncoding: 'msgpack', structures: true });
+    const collection = mdbx.collection(env, 'structures-test', { valueEncoding: 'msgpack', structures: true });
+    for (let i = 0; i < 10; i++) {
+      collection.put(`user:${i}`, { name: `user${i}`, email: `user${i}@example.com`, age: 20 + i });
+    }
+    expect(collection.get('user:3')).toEqual({ name: 'user3', email: 'user3@example.com', age: 23 });
+    expect(collection.find({ gte: 'user:8' }).map((entry) => entry.value.age)).toEqual([28, 29]);
+
+    const txn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    const stored = txn.get(db, 'user:3');
+    txn.abort();
+    expect(stored.length).toBeLessThan(mdbx.encodeValue({ name: 'user3', email: 'user3@example.com', age: 23 }).length);
+    expect(() => mdbx.decodeValue(stored)).toThrow();
+
+    // Structures defined by an aborted transaction are forgotten by the
+    // handle that defined them
+    const aborted = env.beginTransaction();
+    aborted.put(db, 'other', { x: 1, y: 2 });
+    aborted.abort();
+    const retry = env.beginTransaction();
+    retry.put(db, 'other', { x: 3, y: 4 });
+    retry.commit();
+    const check = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    expect(check.getDecoded(db, 'other')).toEqual({ x: 3, y: 4 });
+    check.abort();
+
+    // Handles opened later reuse the stored definitions
+    const store = mdbx.collection(env, '__mdbxjs_structures');
+    const defined = store.count();
+    const reopened = mdbx.collection(env, 'structures-test', { valueEncoding: 'msgpack', structures: true });
+    reopened.put('user:10', { name: 'user10', email: 'user10@example.com', age: 30 });
+    reopened.put('other', { x: 5, y: 6 });
+    expect(store.count()).toBe(defined);
+    db.close();
+  });
+
+  test('Compressed values round-trip through get, find and async reads', async () => {
+    const db = env.openDatabase({ name: 'compressed-test', compression: { threshold: 64 } });
+    const collection = mdbx.collection(env, 'compressed-test', { compression: { threshold: 64 } });
+    const event = (i) => ({ type: 'page_view', path: `/articles/${i}`, agent: 'Mozilla/5.0 (X11; Linux x86_64)', i });
+    for (let i = 0; i < 50; i++) {
+      collection.put(`event:${i}`, event(i));
+    }
+    collection.put('small', 1);
+
+    expect(collection.get('event:7')).toEqual(event(7));
+    expect(collection.get('small')).toBe(1);
+
+    // Handles opened after training pick up the stored dictionary
+    expect(db.trainDictionary({ maxSize: 1024 })).toBeGreaterThan(0);
+    const trained = mdbx.collection(env, 'compressed-test', { compression: { threshold: 64 } });
+    trained.put('event:7', event(7));
+    expect(collection.get('event:7')).toEqual(event(7));
+    expect(collection.find({ gte: 'event:0', lt: 'event:2' }).map((entry) => entry.value.i)).toEqual([0, 1, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19]);
+    expect(await collection.getAsync('event:7')).toEqual(event(7));
+
+    // The setting is stored with the database, so it can't be opened with
+    // the other one
+    expect(() => env.openDatabase({ name: 'compressed-test' })).toThrow(/created with compression/);
+    mdbx.collection(env, 'plain-test').put('key1', 'value1');
+    expect(() => env.openDatabase({ name: 'plain-test', compression: true })).toThrow(/created without compression/);
+    db.close();
+  });
+
+  test('Async get/put/del run on the threadpool', async () => {
+    const collection = mdbx.collection(env, 'async-test');
+
+    await collection.putAsync('key1', { name: 'Async' });
+    expect(await collection.getAsync('key1')).toEqual({ name: 'Async' });
+    expect(collection.get('key1')).toEqual({ name: 'Async' });
+
+    expect(await collection.delAsync('key1')).toBe(true);
+    expect(await collection.delAsync('key1')).toBe(false);
+    expect(await collection.getAsync('key1')).toBeNull();
+  });
+
+  test('Writer commits queued operations together', async () => {
+    const collection = mdbx.collection(env, 'writer-test');
+    const db = env.openDatabase({ name: 'writer-test' });
+
+    const puts = [];
+    for (let i = 0; i < 100; i++) {
+      puts.push(env.writer.put(db, `key${i}`, `value${i}`));
+    }
+    await Promise.all(puts);
+    expect(collection.count()).toBe(100);
+
+    await expect(env.writer.put(db, 'key1', 'other', mdbx.WriteFlags.NOOVERWRITE)).rejects.toThrow();
+    expect(await env.writer.del(db, 'key2')).toBe(true);
+    await env.writer.flush();
+    expect(collection.get('key1')).toBe('value1');
+    expect(collection.get('key2')).toBeNull();
+  });
+
   test('Collection clear method', () => {
     const collection = mdbx.collection(env, 'clear-test');
     
@@ -127,6 +419,12 @@ describe('Basic MDBXJS operations', () => {
     }
     
     expect(collection.count()).toBe(5);
+    expect(collection.countRange('key1', 'key4')).toBe(3);
+
+    expect(collection.deleteRange('key2', 'key4')).toBe(2);
+    expect(collection.count()).toBe(3);
+    expect(collection.get('key2')).toBeNull();
+    expect(collection.get('key4')).toBe('value4');
     
     // Clear the collection
     collection.clear();
@@ -175,6 +473,112 @@ describe('Advanced MDBXJS operations', () => {
     txn2.abort();
   });
 
+  test('commitAsync makes a NOSYNC commit durable off the main thread', async () => {
+    const db = env.openDatabase({ name: 'commit-async-test', create: true });
+    const txn = env.beginTransaction({ asyncCommit: true });
+    txn.put(db, 'key1', 'value1');
+    await txn.commitAsync();
+    expect(() => txn.commit()).toThrow();
+
+    // A durable write transaction would fsync on this thread
+    const durable = env.beginTransaction();
+    expect(() => durable.commitAsync()).toThrow(/asyncCommit/);
+    durable.abort();
+
+    const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    expect(readTxn.get(db, 'key1').toString()).toBe('value1');
+    readTxn.abort();
+  });
+
+  test('getMany looks up keys in one call', () => {
+    const db = env.openDatabase({ name: 'get-many-test', create: true });
+    const txn = env.beginTransaction();
+    txn.put(db, 'b', 'value-b');
+    txn.put(db, 'a', 'value-a');
+    txn.put(db, 'c', 'value-c');
+    txn.commit();
+
+    const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    const values = readTxn.getMany(db, ['c', 'missing', 'a', 'c']);
+    expect(values.map((v) => v && v.toString())).toEqual(['value-c', null, 'value-a', 'value-c']);
+
+    const packed = readTxn.getMany(db, mdbx.packRecords([Buffer.from('b'), Buffer.from('nope')]));
+    const records = mdbx.unpackRecords(packed);
+    expect(records[0].toString()).toBe('value-b');
+    expect(records[1]).toBeNull();
+    readTxn.abort();
+  });
+
+  test('putMany writes packed and array batches', () => {
+    const db = env.openDatabase({ name: 'put-many-test', create: true });
+    const txn = env.beginTransaction();
+    expect(txn.putMany(db, ['a', 'b'], ['value-a', 'value-b'])).toBe(2);
+    const packed = mdbx.packRecords([Buffer.from('b'), Buffer.from('other'), Buffer.from('c'), Buffer.from('value-c')]);
+    expect(txn.putMany(db, packed, mdbx.WriteFlags.NOOVERWRITE)).toBe(1);
+    txn.commit();
+
+    const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    const values = readTxn.getMany(db, ['a', 'b', 'c']);
+    expect(values.map((v) => v.toString())).toEqual(['value-a', 'value-b', 'value-c']);
+    readTxn.abort();
+  });
+
+  test('Cursor getRange returns packed pairs within bounds', () => {
+    const db = env.openDatabase({ name: 'range-test', create: true });
+    const txn = env.beginTransaction();
+    for (let i = 0; i < 1000; i++) {
+      txn.put(db, `key${String(i).padStart(4, '0')}`, `value${i}`);
+    }
+    txn.commit();
+
+    const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    const cursor = readTxn.openCursor(db);
+
+    let records = mdbx.unpackRecords(cursor.getRange({ start: 'key0100', end: 'key0900' }));
+    expect(records.length).toBe(1600);
+    expect(records[0].toString()).toBe('key0100');
+    expect(records[1].toString()).toBe('value100');
+    expect(records[1598].toString()).toBe('key0899');
+
+    records = mdbx.unpackRecords(cursor.getRange({ start: 'key0100', end: 'key0900', exclusiveStart: true, inclusiveEnd: true, reverse: true, limit: 3 }));
+    expect(records.filter((r, i) => i % 2 === 0).map(String)).toEqual(['key0900', 'key0899', 'key0898']);
+
+    records = mdbx.unpackRecords(cursor.getRange({ start: 'key0990', limit: Infinity }));
+    expect(records.length).toBe(20);
+
+    expect(cursor.countRange({ start: 'key0100', end: 'key0900' })).toBe(800);
+    expect(cursor.countRange({ start: 'key0990' })).toBe(10);
+    expect(cursor.countRange({ end: 'key0100', reverse: true })).toBe(100);
+
+    cursor.close();
+    readTxn.abort();
+  });
+
+  test('Zero-copy reads are detached when the transaction ends', () => {
+    const db = env.openDatabase({ name: 'zero-copy-test', create: true });
+    const txn = env.beginTransaction();
+    txn.put(db, 'key1', 'value1');
+
+    // Dirty pages of a write transaction are copied
+    const dirty = txn.get(db, 'key1');
+    txn.commit();
+    expect(dirty.toString()).toBe('value1');
+
+    const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY, zeroCopy: true });
+    const mapped = readTxn.get(db, 'key1');
+    expect(mapped.toString()).toBe('value1');
+
+    const cursor = readTxn.openCursor(db);
+    const entry = cursor.get(mdbx.SeekOperation.SET, 'key1');
+    expect(entry.key.toString()).toBe('key1');
+    expect(entry.value.toString()).toBe('value1');
+    cursor.close();
+
+    readTxn.abort();
+    expect(mapped.length).toBe(0);
+    expect(entry.value.length).toBe(0);
+  });
+
   test('Cursor operations', () => {
     // Start transaction and open database
     const txn = env.beginTransaction();
@@ -226,6 +630,78 @@ describe('Advanced MDBXJS operations', () => {
     txn.commit();
   });
 
+  test('Environments on the same path share one native environment', async () => {
+    const envPath = path.join(TEST_DIR, 'shared-test-' + Date.now());
+    const first = mdbx.open(envPath);
+    const second = mdbx.open(envPath);
+
+    mdbx.collection(first, 'shared').put('key1', 'value1');
+    expect(mdbx.collection(second, 'shared').get('key1')).toBe('value1');
+
+    first.close();
+    expect(mdbx.collection(second, 'shared').get('key1')).toBe('value1');
+    // The thread keeps its reader slot while second is still attached
+    expect(second.readers().some((reader) => reader.pid === process.pid)).toBe(true);
+
+    const fromWorker = await new Promise((resolve, reject) => {
+      const worker = new Worker(`
+        const { parentPort, workerData } = require('worker_threads');
+        const mdbx = require(workerData.lib);
+        const env = mdbx.open(workerData.path);
+        parentPort.postMessage(mdbx.collection(env, 'shared').get('key1'));
+        env.close();
+      `, { eval: true, workerData: { lib: path.join(__dirname, '../lib'), path: envPath } });
+      worker.once('message', resolve);
+      worker.once('error', reject);
+    });
+    expect(fromWorker).toBe('value1');
+
+    second.close();
+  });
+
+  test('Transaction getAsync requires NOTLS', async () => {
+    const db = env.openDatabase({ name: 'async-txn-test', create: true });
+    const txn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+
+    expect(() => txn.getAsync(db, 'key1')).toThrow(/NOTLS/);
+    txn.abort();
+
+    const notlsEnv = mdbx.open(path.join(TEST_DIR, 'notls-test-' + Date.now()), {
+      flags: mdbx.EnvFlags.NOTLS
+    });
+    const notlsDb = notlsEnv.openDatabase({ name: 'async-txn-test', create: true });
+    mdbx.collection(notlsEnv, 'async-txn-test').put('key1', 'value1');
+
+    const readTxn = notlsEnv.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    const pending = readTxn.getAsync(notlsDb, 'key1');
+    expect(() => readTxn.abort()).toThrow(/pending async/);
+    expect((await pending).toString()).toBe('value1');
+    readTxn.abort();
+    notlsEnv.close();
+  });
+
+  test('Pooled read-only transactions see the latest snapshot', () => {
+    const db = env.openDatabase({ name: 'pool-test', create: true });
+
+    for (let i = 0; i < 5; i++) {
+      const txn = env.beginTransaction();
+      txn.put(db, 'counter', `${i}`);
+      txn.commit();
+
+      const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+      expect(readTxn.get(db, 'counter').toString()).toBe(`${i}`);
+      readTxn.abort();
+    }
+
+    const resetTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    resetTxn.reset();
+    resetTxn.abort();
+
+    const readTxn = env.beginTransaction({ mode: mdbx.TransactionMode.READONLY });
+    expect(readTxn.get(db, 'counter').toString()).toBe('4');
+    readTxn.commit();
+  });
+
   test('Environment information and statistics', () => {
     // Get environment info
     const info = env.info();